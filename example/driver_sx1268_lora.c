@@ -37,6 +37,7 @@
 #include "driver_sx1268_lora.h"
 
 static sx1268_handle_t gs_handle;        /**< sx1268 handle */
+static const uint16_t gs_retention_reg[3] = {0x08AC, 0x08D8, 0x08E7};        /**< rx gain, tx clamp and ocp registers */
 
 /**
  * @brief  sx1268 lora irq
@@ -57,6 +58,122 @@ uint8_t sx1268_lora_irq_handler(void)
     }
 }
 
+/**
+ * @brief  sx1268 lora irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_top_half(void)
+{
+    if (sx1268_irq_top_half(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  sx1268 lora irq bottom half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the main loop
+ */
+uint8_t sx1268_lora_irq_bottom_half(void)
+{
+    uint8_t num;
+    
+    if (sx1268_irq_bottom_half(&gs_handle, &num) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  sx1268 lora dio1 irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   use it with the multi line irq profile
+ */
+uint8_t sx1268_lora_irq_dio1_handler(void)
+{
+    if (sx1268_irq_line_handler(&gs_handle, SX1268_DIO_LINE_1) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  sx1268 lora dio2 irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   use it with the multi line irq profile
+ */
+uint8_t sx1268_lora_irq_dio2_handler(void)
+{
+    if (sx1268_irq_line_handler(&gs_handle, SX1268_DIO_LINE_2) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  sx1268 lora dio1 irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_dio1_top_half(void)
+{
+    if (sx1268_irq_line_top_half(&gs_handle, SX1268_DIO_LINE_1) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  sx1268 lora dio2 irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_dio2_top_half(void)
+{
+    if (sx1268_irq_line_top_half(&gs_handle, SX1268_DIO_LINE_2) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 /**
  * @brief     lora example init
  * @param[in] *callback points to a callback address
@@ -77,6 +194,7 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
     DRIVER_SX1268_LINK_SPI_INIT(&gs_handle, sx1268_interface_spi_init);
     DRIVER_SX1268_LINK_SPI_DEINIT(&gs_handle, sx1268_interface_spi_deinit);
     DRIVER_SX1268_LINK_SPI_WRITE_READ(&gs_handle, sx1268_interface_spi_write_read);
+    DRIVER_SX1268_LINK_SPI_WRITEV(&gs_handle, sx1268_interface_spi_writev);
     DRIVER_SX1268_LINK_RESET_GPIO_INIT(&gs_handle, sx1268_interface_reset_gpio_init);
     DRIVER_SX1268_LINK_RESET_GPIO_DEINIT(&gs_handle, sx1268_interface_reset_gpio_deinit);
     DRIVER_SX1268_LINK_RESET_GPIO_WRITE(&gs_handle, sx1268_interface_reset_gpio_write);
@@ -84,9 +202,14 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
     DRIVER_SX1268_LINK_BUSY_GPIO_DEINIT(&gs_handle, sx1268_interface_busy_gpio_deinit);
     DRIVER_SX1268_LINK_BUSY_GPIO_READ(&gs_handle, sx1268_interface_busy_gpio_read);
     DRIVER_SX1268_LINK_DELAY_MS(&gs_handle, sx1268_interface_delay_ms);
+    DRIVER_SX1268_LINK_DELAY_US(&gs_handle, sx1268_interface_delay_us);
+    DRIVER_SX1268_LINK_GET_TIME_US(&gs_handle, sx1268_interface_get_time_us);
     DRIVER_SX1268_LINK_DEBUG_PRINT(&gs_handle, sx1268_interface_debug_print);
     DRIVER_SX1268_LINK_RECEIVE_CALLBACK(&gs_handle, callback);
     
+    /* set the start mode */
+    (void)sx1268_set_fast_start(&gs_handle, SX1268_LORA_DEFAULT_FAST_START);
+    
     /* init the sx1268 */
     res = sx1268_init(&gs_handle);
     if (res != 0)
@@ -96,6 +219,68 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
         return 1;
     }
     
+    /* enable the register cache */
+    res = sx1268_set_register_cache(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set register cache failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* skip unchanged configuration commands */
+    res = sx1268_set_config_diff(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set config diff failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* keep the rx gain, tx clamp and ocp registers in the warm start sleep mode */
+    res = sx1268_set_retention_list(&gs_handle, (uint16_t *)gs_retention_reg, 3);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set retention list failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get tx modulation */
+    res = sx1268_get_tx_modulation(&gs_handle, (uint8_t *)&modulation);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get tx modulation failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    modulation |= 0x04;
+    
+    /* get the tx clamp config */
+    res = sx1268_get_tx_clamp_config(&gs_handle, (uint8_t *)&config);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get tx clamp config failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    config |= 0x1E;
+    
+    /* record the configuration into one batch, the register reads run before it */
+    res = sx1268_batch_begin(&gs_handle, SX1268_LORA_DEFAULT_BATCH_GAP_US);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: batch begin failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* enter standby */
     res = sx1268_set_standby(&gs_handle, SX1268_CLOCK_SOURCE_RC_13M);
     if (res != 0)
@@ -147,10 +332,10 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
     }
     
     /* set dio irq */
-    res = sx1268_set_dio_irq_params(&gs_handle, 0x03FF, 0x03FF, 0x0000, 0x0000);
+    res = sx1268_set_irq_profile(&gs_handle, SX1268_LORA_DEFAULT_IRQ_PROFILE, 0x03FF);
     if (res != 0)
     {
-        sx1268_interface_debug_print("sx1268: set dio irq params failed.\n");
+        sx1268_interface_debug_print("sx1268: set irq profile failed.\n");
         (void)sx1268_deinit(&gs_handle);
         
         return 1;
@@ -267,17 +452,6 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
         return 1;
     }
     
-    /* get tx modulation */
-    res = sx1268_get_tx_modulation(&gs_handle, (uint8_t *)&modulation);
-    if (res != 0)
-    {
-        sx1268_interface_debug_print("sx1268: get tx modulation failed.\n");
-        (void)sx1268_deinit(&gs_handle);
-        
-        return 1;
-    }
-    modulation |= 0x04;
-    
     /* set the tx modulation */
     res = sx1268_set_tx_modulation(&gs_handle, modulation);
     if (res != 0)
@@ -308,22 +482,21 @@ uint8_t sx1268_lora_init(void (*callback)(uint16_t type, uint8_t *buf, uint16_t
         return 1;
     }
     
-    /* get the tx clamp config */
-    res = sx1268_get_tx_clamp_config(&gs_handle, (uint8_t *)&config);
+    /* set the tx clamp config */
+    res = sx1268_set_tx_clamp_config(&gs_handle, config);
     if (res != 0)
     {
-        sx1268_interface_debug_print("sx1268: get tx clamp config failed.\n");
+        sx1268_interface_debug_print("sx1268: set tx clamp config failed.\n");
         (void)sx1268_deinit(&gs_handle);
         
         return 1;
     }
-    config |= 0x1E;
     
-    /* set the tx clamp config */
-    res = sx1268_set_tx_clamp_config(&gs_handle, config);
+    /* commit the batch */
+    res = sx1268_batch_commit(&gs_handle);
     if (res != 0)
     {
-        sx1268_interface_debug_print("sx1268: set tx clamp config failed.\n");
+        sx1268_interface_debug_print("sx1268: batch commit failed.\n");
         (void)sx1268_deinit(&gs_handle);
         
         return 1;
@@ -379,9 +552,7 @@ uint8_t sx1268_lora_sleep(void)
  */
 uint8_t sx1268_lora_wake_up(void)
 {
-    uint8_t status;
-    
-    if (sx1268_get_status(&gs_handle, (uint8_t *)&status) != 0)
+    if (sx1268_wake_up(&gs_handle) != 0)
     {
         return 1;
     }
@@ -403,9 +574,8 @@ uint8_t sx1268_lora_set_continuous_receive_mode(void)
     uint8_t setup;
     
     /* set dio irq */
-    if (sx1268_set_dio_irq_params(&gs_handle, SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  0x0000, 0x0000) != 0)
+    if (sx1268_set_irq_profile(&gs_handle, SX1268_LORA_DEFAULT_IRQ_PROFILE,
+                               SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED) != 0)
     {
         return 1;
     }
@@ -452,20 +622,24 @@ uint8_t sx1268_lora_set_continuous_receive_mode(void)
 }
 
 /**
- * @brief  lora example enter to the shot receive mode
- * @return status code
- *         - 0 success
- *         - 1 enter failed
- * @note   none
+ * @brief     lora example enter to the shot receive mode
+ * @param[in] us is the timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 enter failed
+ * @note      none
  */
+#if (SX1268_FLOAT_API == 1)
 uint8_t sx1268_lora_set_shot_receive_mode(double us)
+#else
+uint8_t sx1268_lora_set_shot_receive_mode(uint32_t us)
+#endif
 {
     uint8_t setup;
     
     /* set dio irq */
-    if (sx1268_set_dio_irq_params(&gs_handle, SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  0x0000, 0x0000) != 0)
+    if (sx1268_set_irq_profile(&gs_handle, SX1268_LORA_DEFAULT_IRQ_PROFILE,
+                               SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CRC_ERR | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED) != 0)
     {
         return 1;
     }
@@ -503,10 +677,17 @@ uint8_t sx1268_lora_set_shot_receive_mode(double us)
     }
     
     /* start receive */
+#if (SX1268_FLOAT_API == 1)
     if (sx1268_single_receive(&gs_handle, us) != 0)
     {
         return 1;
     }
+#else
+    if (sx1268_single_receive_integer(&gs_handle, us) != 0)
+    {
+        return 1;
+    }
+#endif
     
     return 0;
 }
@@ -520,10 +701,8 @@ uint8_t sx1268_lora_set_shot_receive_mode(double us)
  */
 uint8_t sx1268_lora_set_sent_mode(void)
 {
-    /* set dio irq */
-    if (sx1268_set_dio_irq_params(&gs_handle, SX1268_IRQ_TX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  SX1268_IRQ_TX_DONE | SX1268_IRQ_TIMEOUT | SX1268_IRQ_CAD_DONE | SX1268_IRQ_CAD_DETECTED,
-                                  0x0000, 0x0000) != 0)
+    /* set dio irq, the data is sent without a chip timeout so tx done is the only irq of the line */
+    if (sx1268_set_irq_profile(&gs_handle, SX1268_LORA_DEFAULT_IRQ_PROFILE, SX1268_LORA_DEFAULT_SENT_IRQ_MASK) != 0)
     {
         return 1;
     }
@@ -589,13 +768,14 @@ uint8_t sx1268_lora_run_cad(sx1268_bool_t *enable)
 
 /**
  * @brief      lora example get the status
- * @param[out] *rssi points to a rssi buffer
- * @param[out] *snr points to a snr buffer
+ * @param[out] *rssi points to a rssi buffer, in 0.01 dBm without the float api
+ * @param[out] *snr points to a snr buffer, in 0.01 dB without the float api
  * @return     status code
  *             - 0 success
  *             - 1 get status failed
  * @note       none
  */
+#if (SX1268_FLOAT_API == 1)
 uint8_t sx1268_lora_get_status(float *rssi, float *snr)
 {
     uint8_t rssi_pkt_raw;
@@ -612,6 +792,20 @@ uint8_t sx1268_lora_get_status(float *rssi, float *snr)
     
     return 0;
 }
+#else
+uint8_t sx1268_lora_get_status(int16_t *rssi, int16_t *snr)
+{
+    int16_t signal_rssi_pkt;
+    
+    /* get the status */
+    if (sx1268_get_lora_packet_status_integer(&gs_handle, rssi, snr, (int16_t *)&signal_rssi_pkt) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
 
 /**
  * @brief      lora example check packet error
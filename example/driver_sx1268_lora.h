@@ -78,6 +78,10 @@ extern "C"{
 #define SX1268_LORA_DEFAULT_CAD_DET_MIN                 10                                /**< 10 */
 #define SX1268_LORA_DEFAULT_START_MODE                  SX1268_START_MODE_WARM            /**< warm mode */
 #define SX1268_LORA_DEFAULT_RTC_WAKE_UP                 SX1268_BOOL_TRUE                  /**< enable rtc wake up */
+#define SX1268_LORA_DEFAULT_BATCH_GAP_US                100                               /**< 100 us between batch commands */
+#define SX1268_LORA_DEFAULT_FAST_START                  SX1268_BOOL_TRUE                  /**< wait for the busy pin after reset */
+#define SX1268_LORA_DEFAULT_IRQ_PROFILE                 SX1268_IRQ_PROFILE_COMPLETION     /**< only completion irqs raise dio1, use multi line with the dio2 irq wired */
+#define SX1268_LORA_DEFAULT_SENT_IRQ_MASK               SX1268_IRQ_TX_DONE                /**< tx done alone, the dio handler skips the irq status read */
 
 /**
  * @brief  sx1268 lora irq
@@ -88,6 +92,60 @@ extern "C"{
  */
 uint8_t sx1268_lora_irq_handler(void);
 
+/**
+ * @brief  sx1268 lora irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_top_half(void);
+
+/**
+ * @brief  sx1268 lora irq bottom half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the main loop
+ */
+uint8_t sx1268_lora_irq_bottom_half(void);
+
+/**
+ * @brief  sx1268 lora dio1 irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   use it with the multi line irq profile
+ */
+uint8_t sx1268_lora_irq_dio1_handler(void);
+
+/**
+ * @brief  sx1268 lora dio2 irq
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   use it with the multi line irq profile
+ */
+uint8_t sx1268_lora_irq_dio2_handler(void);
+
+/**
+ * @brief  sx1268 lora dio1 irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_dio1_top_half(void);
+
+/**
+ * @brief  sx1268 lora dio2 irq top half
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   it is isr safe
+ */
+uint8_t sx1268_lora_irq_dio2_top_half(void);
+
 /**
  * @brief     lora example init
  * @param[in] *callback points to a callback address
@@ -116,14 +174,27 @@ uint8_t sx1268_lora_deinit(void);
  */
 uint8_t sx1268_lora_set_continuous_receive_mode(void);
 
+#if (SX1268_FLOAT_API == 1)
 /**
- * @brief  lora example enter to the shot receive mode
- * @return status code
- *         - 0 success
- *         - 1 enter failed
- * @note   none
+ * @brief     lora example enter to the shot receive mode
+ * @param[in] us is the timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 enter failed
+ * @note      none
  */
 uint8_t sx1268_lora_set_shot_receive_mode(double us);
+#else
+/**
+ * @brief     lora example enter to the shot receive mode
+ * @param[in] us is the timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 enter failed
+ * @note      none
+ */
+uint8_t sx1268_lora_set_shot_receive_mode(uint32_t us);
+#endif
 
 /**
  * @brief  lora example enter to the sent mode
@@ -155,6 +226,7 @@ uint8_t sx1268_lora_sent(uint8_t *buf, uint16_t len);
  */
 uint8_t sx1268_lora_run_cad(sx1268_bool_t *enable);
 
+#if (SX1268_FLOAT_API == 1)
 /**
  * @brief      lora example get the status
  * @param[out] *rssi points to a rssi buffer
@@ -165,6 +237,18 @@ uint8_t sx1268_lora_run_cad(sx1268_bool_t *enable);
  * @note       none
  */
 uint8_t sx1268_lora_get_status(float *rssi, float *snr);
+#else
+/**
+ * @brief      lora example get the status
+ * @param[out] *rssi points to a rssi buffer in 0.01 dBm
+ * @param[out] *snr points to a snr buffer in 0.01 dB
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ * @note       none
+ */
+uint8_t sx1268_lora_get_status(int16_t *rssi, int16_t *snr);
+#endif
 
 /**
  * @brief      lora example check packet error
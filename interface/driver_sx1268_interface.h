@@ -82,6 +82,17 @@ uint8_t sx1268_interface_spi_deinit(void);
 uint8_t sx1268_interface_spi_write_read(uint8_t *in_buf, uint32_t in_len,
                                         uint8_t *out_buf, uint32_t out_len);
 
+/**
+ * @brief     interface spi bus writev
+ * @param[in] *seg points to a segment buffer
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 writev failed
+ * @note      none
+ */
+uint8_t sx1268_interface_spi_writev(sx1268_spi_segment_t *seg, uint8_t num);
+
 /**
  * @brief  interface reset gpio init
  * @return status code
@@ -145,6 +156,23 @@ uint8_t sx1268_interface_busy_gpio_read(uint8_t *value);
  */
 void sx1268_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void sx1268_interface_delay_us(uint32_t us);
+
+/**
+ * @brief      interface get the monotonic time
+ * @param[out] *us points to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ * @note       none
+ */
+uint8_t sx1268_interface_get_time_us(uint32_t *us);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
@@ -77,6 +77,20 @@ uint8_t sx1268_interface_spi_write_read(uint8_t *in_buf, uint32_t in_len,
     return 0;
 }
 
+/**
+ * @brief     interface spi bus writev
+ * @param[in] *seg points to a segment buffer
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 writev failed
+ * @note      none
+ */
+uint8_t sx1268_interface_spi_writev(sx1268_spi_segment_t *seg, uint8_t num)
+{
+    return 0;
+}
+
 /**
  * @brief  interface reset gpio init
  * @return status code
@@ -161,6 +175,29 @@ void sx1268_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void sx1268_interface_delay_us(uint32_t us)
+{
+
+}
+
+/**
+ * @brief      interface get the monotonic time
+ * @param[out] *us points to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ * @note       none
+ */
+uint8_t sx1268_interface_get_time_us(uint32_t *us)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
@@ -57,7 +57,7 @@
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   dio1 and dio2 are served by one pthread so their irqs never run at the same time
  */
 uint8_t gpio_interrupt_init(void);
 
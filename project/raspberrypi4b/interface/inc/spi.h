@@ -61,6 +61,18 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 }spi_mode_type_t;
 
+/**
+ * @brief spi transfer structure definition
+ */
+typedef struct spi_transfer_s
+{
+    uint8_t *tx_buf;          /**< tx buffer, NULL means sending zero */
+    uint8_t *rx_buf;          /**< rx buffer, NULL means dropping the received data */
+    uint32_t len;             /**< transfer length */
+    uint8_t cs_change;        /**< deassert cs after this transfer */
+    uint16_t delay_us;        /**< delay in us with cs high after a cs_change transfer */
+} spi_transfer_t;
+
 /**
  * @brief      spi bus init
  * @param[in]  *name points to a spi device name buffer
@@ -148,6 +160,20 @@ uint8_t spi_write(int fd, uint8_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len);
 
+/**
+ * @brief     spi bus transfer a message
+ * @param[in] fd is the spi handle
+ * @param[in] *transfer points to a transfer buffer
+ * @param[in] num is the transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the transfers of one cs cycle are submitted with one ioctl, a transfer with cs_change
+ *            ends the cycle and its delay_us is waited with cs high before the next cycle starts,
+ *            spidev delay_usecs would run before cs rises so it is not used
+ */
+uint8_t spi_transfer(int fd, spi_transfer_t *transfer, uint32_t num);
+
 #ifdef __cplusplus
 }
 #endif
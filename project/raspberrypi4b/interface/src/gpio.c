@@ -45,6 +45,7 @@
  * @brief gpio device line definition
  */
 #define GPIO_DEVICE_LINE 22                      /**< gpio device line */
+#define GPIO_DEVICE_LINE_DIO2 23                 /**< gpio device dio2 line */
 
 /**
  * @brief global var definition
@@ -53,6 +54,9 @@ static struct gpiod_chip *gs_chip;               /**< gpio chip handle */
 static struct gpiod_line *gs_line;               /**< gpio line handle */
 static pthread_t gs_pid;                         /**< gpio pthread pid */
 extern uint8_t (*g_gpio_irq)(void);              /**< gpio irq function address */
+static struct gpiod_line *gs_line_dio2;          /**< gpio dio2 line handle */
+static struct gpiod_line_bulk gs_bulk;           /**< gpio line bulk */
+extern uint8_t (*g_gpio_irq_dio2)(void);         /**< gpio dio2 irq function address */
 
 /**
  * @brief  gpio interrupt pthread
@@ -63,26 +67,43 @@ extern uint8_t (*g_gpio_irq)(void);              /**< gpio irq function address
 static void *gpio_interrupt_pthread(void *p)
 {
     int res;
+    unsigned int i;
+    struct gpiod_line *line;
+    struct gpiod_line_bulk event_bulk;
     struct gpiod_line_event event;
 
     pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
     while (1)
     {
-        res = gpiod_line_event_wait(gs_line, NULL);
+        res = gpiod_line_event_wait_bulk(&gs_bulk, NULL, &event_bulk);
         if (res == 1)
         {
-             if (gpiod_line_event_read(gs_line, &event) != 0)
-             {
-                 continue;
-             }
-             if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
-             {
-                if (g_gpio_irq)
+            for (i = 0; i < gpiod_line_bulk_num_lines(&event_bulk); i++)
+            {
+                line = gpiod_line_bulk_get_line(&event_bulk, i);
+                if (gpiod_line_event_read(line, &event) != 0)
                 {
-                    g_gpio_irq();
+                    continue;
                 }
-             }
+                if (event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
+                {
+                    if (line == gs_line)
+                    {
+                        if (g_gpio_irq)
+                        {
+                            g_gpio_irq();
+                        }
+                    }
+                    else
+                    {
+                        if (g_gpio_irq_dio2)
+                        {
+                            g_gpio_irq_dio2();
+                        }
+                    }
+                }
+            }
         }
     }
 }
@@ -92,7 +113,7 @@ static void *gpio_interrupt_pthread(void *p)
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   dio1 and dio2 are served by one pthread so their irqs never run at the same time
  */
 uint8_t gpio_interrupt_init(void)
 {
@@ -113,7 +134,18 @@ uint8_t gpio_interrupt_init(void)
 
         return 1;
     }
-    if (gpiod_line_request_rising_edge_events(gs_line, "gpiointerrupt") < 0)
+    gs_line_dio2 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_DIO2);
+    if (!gs_line_dio2) 
+    {
+        perror("gpio: get dio2 line failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    gpiod_line_bulk_init(&gs_bulk);
+    gpiod_line_bulk_add(&gs_bulk, gs_line);
+    gpiod_line_bulk_add(&gs_bulk, gs_line_dio2);
+    if (gpiod_line_request_bulk_rising_edge_events(&gs_bulk, "gpiointerrupt") < 0)
     {
         perror("gpio: set rising edge events failed.\n");
         gpiod_chip_close(gs_chip);
@@ -373,3 +373,67 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
 
     return 0;                                                 /* success return 0 */
 }
+
+/**
+ * @brief     spi bus transfer a message
+ * @param[in] fd is the spi handle
+ * @param[in] *transfer points to a transfer buffer
+ * @param[in] num is the transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the transfers of one cs cycle are submitted with one ioctl, a transfer with cs_change
+ *            ends the cycle and its delay_us is waited with cs high before the next cycle starts,
+ *            spidev delay_usecs would run before cs rises so it is not used
+ */
+uint8_t spi_transfer(int fd, spi_transfer_t *transfer, uint32_t num)
+{
+    struct spi_ioc_transfer k[256];
+    uint32_t i;
+    uint32_t start;
+    uint32_t total;
+    int l;
+    
+    if ((num == 0) || (num > 256))                                /* check the number */
+    {
+        perror("spi: transfer number error.\n");                 /* transfer number error */
+        
+        return 1;                                                 /* return error */
+    }
+    
+    start = 0;                                                    /* first cycle */
+    while (start < num)                                           /* all cs cycles */
+    {
+        memset(k, 0, sizeof(struct spi_ioc_transfer) * num);      /* clear ioc transfer */
+        total = 0;                                                /* init 0 */
+        for (i = start; i < num; i++)                             /* set the transfers of this cycle */
+        {
+            k[i - start].tx_buf = (unsigned long)transfer[i].tx_buf;  /* set tx buffer */
+            k[i - start].rx_buf = (unsigned long)transfer[i].rx_buf;  /* set rx buffer */
+            k[i - start].len = transfer[i].len;                   /* set length */
+            total += transfer[i].len;                             /* add length */
+            if (transfer[i].cs_change != 0)                       /* end of the cycle */
+            {
+                break;                                            /* break */
+            }
+        }
+        if (i == num)                                             /* last cycle */
+        {
+            i = num - 1;                                          /* last transfer */
+        }
+        l = ioctl(fd, SPI_IOC_MESSAGE(i - start + 1), k);         /* send data, cs rises at the end */
+        if (l != (int)total)                                      /* check length */
+        {
+            perror("spi: length check error.\n");                /* length check error */
+            
+            return 1;                                             /* return error */
+        }
+        if ((transfer[i].cs_change != 0) && (transfer[i].delay_us != 0) && (i != (num - 1)))   /* gap with cs high */
+        {
+            usleep(transfer[i].delay_us);                         /* wait */
+        }
+        start = i + 1;                                            /* next cycle */
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
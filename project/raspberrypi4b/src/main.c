@@ -43,6 +43,7 @@
 
 uint8_t g_flag;                            /**< interrupt flag */
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
+uint8_t (*g_gpio_irq_dio2)(void) = NULL;   /**< gpio dio2 irq function address */
 static uint8_t gs_rx_done;                 /**< rx done */
 
 /**
@@ -66,18 +67,28 @@ static void a_callback(uint16_t type, uint8_t *buf, uint16_t len)
         {
             uint16_t i;
             sx1268_bool_t enable;
+#if (SX1268_FLOAT_API == 1)
             float rssi;
             float snr;
+#else
+            int16_t rssi;
+            int16_t snr;
+#endif
             
             sx1268_interface_debug_print("sx1268: irq rx done.\n");
             
             /* get the status */
-            if (sx1268_lora_get_status((float *)&rssi, (float *)&snr) != 0)
+            if (sx1268_lora_get_status(&rssi, &snr) != 0)
             {
                 return;
             }
+#if (SX1268_FLOAT_API == 1)
             sx1268_interface_debug_print("sx1268: rssi is %0.1f.\n", rssi);
             sx1268_interface_debug_print("sx1268: snr is %0.2f.\n", snr);
+#else
+            sx1268_interface_debug_print("sx1268: rssi is %d 0.01dBm.\n", rssi);
+            sx1268_interface_debug_print("sx1268: snr is %d 0.01dB.\n", snr);
+#endif
             
             /* check the error */
             if (sx1268_lora_check_packet_error(&enable) != 0)
@@ -198,6 +209,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
             sx1268_interface_debug_print("sx1268: CS connected to GPIO8(BCM).\n");
             sx1268_interface_debug_print("sx1268: RST connected to GPIO27(BCM).\n");
             sx1268_interface_debug_print("sx1268: DIO1 connected to GPIO22(BCM).\n");
+            sx1268_interface_debug_print("sx1268: DIO2 connected to GPIO23(BCM).\n");
             sx1268_interface_debug_print("sx1268: BUSY connected to GPIO17(BCM).\n");
             
             return 0;
@@ -284,11 +296,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -317,11 +331,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -355,7 +371,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_handler;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_handler;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -363,6 +380,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -374,6 +392,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -394,11 +413,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -513,11 +534,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -550,7 +573,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_handler;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_handler;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -558,6 +582,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -569,6 +594,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -582,6 +608,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -592,11 +619,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -621,7 +650,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_handler;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_handler;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -629,6 +659,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -645,6 +676,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -661,6 +693,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -671,11 +704,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -82,6 +82,36 @@ uint8_t sx1268_interface_spi_write_read(uint8_t *in_buf, uint32_t in_len,
     return spi_write_read(in_buf, in_len, out_buf, out_len);
 }
 
+/**
+ * @brief     interface spi bus writev
+ * @param[in] *seg points to a segment buffer
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 writev failed
+ * @note      none
+ */
+uint8_t sx1268_interface_spi_writev(sx1268_spi_segment_t *seg, uint8_t num)
+{
+    spi_transfer_t transfer[SX1268_BATCH_MAX_NUM];
+    uint8_t i;
+    
+    if (num > SX1268_BATCH_MAX_NUM)
+    {
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        transfer[i].tx_buf = seg[i].tx_buf;
+        transfer[i].rx_buf = seg[i].rx_buf;
+        transfer[i].len = seg[i].len;
+        transfer[i].cs_change = seg[i].cs_change;
+        transfer[i].delay_us = seg[i].delay_us;
+    }
+    
+    return spi_transfer(transfer, num);
+}
+
 /**
  * @brief  interface reset gpio init
  * @return status code
@@ -166,6 +196,31 @@ void sx1268_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us
+ * @note      none
+ */
+void sx1268_interface_delay_us(uint32_t us)
+{
+    delay_us(us);
+}
+
+/**
+ * @brief      interface get the monotonic time
+ * @param[out] *us points to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ * @note       none
+ */
+uint8_t sx1268_interface_get_time_us(uint32_t *us)
+{
+    *us = delay_get_time_us();
+    
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt is the format data
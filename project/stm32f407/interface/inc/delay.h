@@ -71,6 +71,13 @@ void delay_us(uint32_t us);
  */
 void delay_ms(uint32_t ms);
 
+/**
+ * @brief  get the time in us
+ * @return time in us
+ * @note   none
+ */
+uint32_t delay_get_time_us(void);
+
 /**
  * @}
  */
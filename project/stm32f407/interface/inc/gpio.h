@@ -53,7 +53,7 @@
  * @brief  gpio interrupt init
  * @return status code
  *         - 0 success
- * @note   gpio pin is PB0
+ * @note   gpio pin is PB0 for dio1 and PB5 for dio2
  */
 uint8_t gpio_interrupt_init(void);
 
@@ -61,7 +61,7 @@ uint8_t gpio_interrupt_init(void);
  * @brief  gpio interrupt deinit
  * @return status code
  *         - 0 success
- * @note   gpio pin is PB0
+ * @note   gpio pin is PB0 for dio1 and PB5 for dio2
  */
 uint8_t gpio_interrupt_deinit(void);
 
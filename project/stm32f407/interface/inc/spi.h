@@ -60,6 +60,18 @@ typedef enum
     SPI_MODE_3 = 0x03,        /**< mode 3 */
 }spi_mode_t;
 
+/**
+ * @brief spi transfer structure definition
+ */
+typedef struct spi_transfer_s
+{
+    uint8_t *tx_buf;          /**< tx buffer, NULL means sending zero */
+    uint8_t *rx_buf;          /**< rx buffer, NULL means dropping the received data */
+    uint32_t len;             /**< transfer length */
+    uint8_t cs_change;        /**< deassert cs after this transfer */
+    uint16_t delay_us;        /**< delay in us with cs high after a cs_change transfer */
+} spi_transfer_t;
+
 /**
  * @brief  spi bus init
  * @return status code
@@ -137,6 +149,17 @@ uint8_t spi_write_cmd(uint8_t *buf, uint16_t len);
  */
 uint8_t spi_write_read(uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint32_t out_len);
 
+/**
+ * @brief     spi bus transfer a message
+ * @param[in] *transfer points to a transfer buffer
+ * @param[in] num is the transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      SCLK is PA5, MOSI is PA7 MISO is PA6 and CS is PA4
+ */
+uint8_t spi_transfer(spi_transfer_t *transfer, uint32_t num);
+
 /**
  * @}
  */
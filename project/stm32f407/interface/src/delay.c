@@ -97,3 +97,22 @@ void delay_ms(uint32_t ms)
 {
     HAL_Delay(ms);
 }
+
+/**
+ * @brief  get the time in us
+ * @return time in us
+ * @note   none
+ */
+uint32_t delay_get_time_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    
+    return ms * 1000 + (SysTick->LOAD + 1 - val) / gs_fac_us;
+}
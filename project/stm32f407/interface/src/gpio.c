@@ -40,7 +40,7 @@
  * @brief  gpio interrupt init
  * @return status code
  *         - 0 success
- * @note   gpio pin is PB0
+ * @note   gpio pin is PB0 for dio1 and PB5 for dio2
  */
 uint8_t gpio_interrupt_init(void)
 {
@@ -48,7 +48,7 @@ uint8_t gpio_interrupt_init(void)
     
     __HAL_RCC_GPIOB_CLK_ENABLE();
  
-    GPIO_InitStruct.Pin = GPIO_PIN_0;
+    GPIO_InitStruct.Pin = GPIO_PIN_0 | GPIO_PIN_5;
     GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
     GPIO_InitStruct.Pull = GPIO_PULLUP;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
@@ -56,6 +56,8 @@ uint8_t gpio_interrupt_init(void)
   
     HAL_NVIC_SetPriority(EXTI0_IRQn, 3, 0);
     HAL_NVIC_EnableIRQ(EXTI0_IRQn);  
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);  
     
     return 0;
 }
@@ -64,12 +66,13 @@ uint8_t gpio_interrupt_init(void)
  * @brief  gpio interrupt deinit
  * @return status code
  *         - 0 success
- * @note   gpio pin is PB0
+ * @note   gpio pin is PB0 for dio1 and PB5 for dio2
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    HAL_GPIO_DeInit(GPIOB, GPIO_PIN_0);
+    HAL_GPIO_DeInit(GPIOB, GPIO_PIN_0 | GPIO_PIN_5);
     HAL_NVIC_DisableIRQ(EXTI0_IRQn);
+    HAL_NVIC_DisableIRQ(EXTI9_5_IRQn);
 
     return 0;
 }
@@ -35,6 +35,7 @@
  */
 
 #include "spi.h"
+#include "delay.h"
 
 /**
  * @brief spi var definition
@@ -302,3 +303,70 @@ uint8_t spi_write_read(uint8_t *in_buf, uint32_t in_len, uint8_t *out_buf, uint3
 
     return 0;
 }
+
+/**
+ * @brief     spi bus transfer a message
+ * @param[in] *transfer points to a transfer buffer
+ * @param[in] num is the transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      SCLK is PA5, MOSI is PA7 MISO is PA6 and CS is PA4
+ */
+uint8_t spi_transfer(spi_transfer_t *transfer, uint32_t num)
+{
+    uint8_t res;
+    uint8_t dummy;
+    uint32_t i;
+    uint32_t j;
+    
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_RESET);
+    
+    for (i = 0; i < num; i++)
+    {
+        if (transfer[i].len == 0)
+        {
+            res = 0;
+        }
+        else if ((transfer[i].tx_buf != NULL) && (transfer[i].rx_buf != NULL))
+        {
+            res = HAL_SPI_TransmitReceive(&g_spi_handle, transfer[i].tx_buf, transfer[i].rx_buf, transfer[i].len, 1000);
+        }
+        else if (transfer[i].tx_buf != NULL)
+        {
+            res = HAL_SPI_Transmit(&g_spi_handle, transfer[i].tx_buf, transfer[i].len, 1000);
+        }
+        else if (transfer[i].rx_buf != NULL)
+        {
+            res = HAL_SPI_Receive(&g_spi_handle, transfer[i].rx_buf, transfer[i].len, 1000);
+        }
+        else
+        {
+            res = 0;
+            for (j = 0; (j < transfer[i].len) && (res == 0); j++)
+            {
+                dummy = 0x00;
+                res = HAL_SPI_Transmit(&g_spi_handle, &dummy, 1, 1000);
+            }
+        }
+        if (res)
+        {
+            HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+            
+            return 1;
+        }
+        if ((transfer[i].cs_change != 0) && (i != (num - 1)))
+        {
+            HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+            if (transfer[i].delay_us != 0)
+            {
+                delay_us(transfer[i].delay_us);
+            }
+            HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_RESET);
+        }
+    }
+    
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+    
+    return 0;
+}
@@ -51,6 +51,7 @@
 uint8_t g_buf[256];                        /**< uart buffer */
 uint16_t g_len;                            /**< uart buffer length */
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq */
+uint8_t (*g_gpio_irq_dio2)(void) = NULL;   /**< gpio dio2 irq */
 static uint8_t gs_rx_done;                 /**< rx done */
 
 /**
@@ -62,6 +63,15 @@ void EXTI0_IRQHandler(void)
     HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
 }
 
+/**
+ * @brief exti 9 5 irq
+ * @note  none
+ */
+void EXTI9_5_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
+}
+
 /**
  * @brief     gpio exti callback
  * @param[in] pin is the gpio pin
@@ -76,6 +86,13 @@ void HAL_GPIO_EXTI_Callback(uint16_t pin)
             g_gpio_irq();
         }
     }
+    else if (pin == GPIO_PIN_5)
+    {
+        if (g_gpio_irq_dio2)
+        {
+            g_gpio_irq_dio2();
+        }
+    }
 }
 
 /**
@@ -99,18 +116,28 @@ static void a_callback(uint16_t type, uint8_t *buf, uint16_t len)
         {
             uint16_t i;
             sx1268_bool_t enable;
+#if (SX1268_FLOAT_API == 1)
             float rssi;
             float snr;
+#else
+            int16_t rssi;
+            int16_t snr;
+#endif
             
             sx1268_interface_debug_print("sx1268: irq rx done.\n");
             
             /* get the status */
-            if (sx1268_lora_get_status((float *)&rssi, (float *)&snr) != 0)
+            if (sx1268_lora_get_status(&rssi, &snr) != 0)
             {
                 return;
             }
+#if (SX1268_FLOAT_API == 1)
             sx1268_interface_debug_print("sx1268: rssi is %0.1f.\n", rssi);
             sx1268_interface_debug_print("sx1268: snr is %0.2f.\n", snr);
+#else
+            sx1268_interface_debug_print("sx1268: rssi is %d 0.01dBm.\n", rssi);
+            sx1268_interface_debug_print("sx1268: snr is %d 0.01dB.\n", snr);
+#endif
             
             /* check the error */
             if (sx1268_lora_check_packet_error(&enable) != 0)
@@ -231,6 +258,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
             sx1268_interface_debug_print("sx1268: CS connected to GPIOA PIN4.\n");
             sx1268_interface_debug_print("sx1268: RST connected to GPIOB PIN1.\n");
             sx1268_interface_debug_print("sx1268: DIO1 connected to GPIOB PIN0.\n");
+            sx1268_interface_debug_print("sx1268: DIO2 connected to GPIOB PIN5.\n");
             sx1268_interface_debug_print("sx1268: BUSY connected to GPIOA PIN8.\n");
             
             return 0;
@@ -317,11 +345,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -350,11 +380,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -388,7 +420,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_top_half;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_top_half;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -396,6 +429,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -407,6 +441,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -427,11 +462,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -546,11 +583,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -583,7 +622,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_top_half;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_top_half;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -591,6 +631,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -602,6 +643,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -615,6 +657,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -625,11 +668,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
@@ -654,7 +699,8 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         return 1;
                     }
-                    g_gpio_irq = sx1268_lora_irq_handler;
+                    g_gpio_irq = sx1268_lora_irq_dio1_top_half;
+                    g_gpio_irq_dio2 = sx1268_lora_irq_dio2_top_half;
                     
                     /* lora init */
                     res = sx1268_lora_init(a_callback);
@@ -662,6 +708,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -678,14 +725,21 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     
                     while ((timeout != 0) && (gs_rx_done == 0))
                     {
+                        uint16_t ms;
+                        
                         timeout--;
-                        sx1268_interface_delay_ms(1000);
+                        for (ms = 0; (ms < 1000) && (gs_rx_done == 0); ms++)
+                        {
+                            (void)sx1268_lora_irq_bottom_half();
+                            sx1268_interface_delay_ms(1);
+                        }
                     }
                     if (gs_rx_done == 0)
                     {
@@ -694,6 +748,7 @@ uint8_t sx1268(uint8_t argc, char **argv)
                         (void)sx1268_lora_deinit();
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
@@ -704,11 +759,13 @@ uint8_t sx1268(uint8_t argc, char **argv)
                     {
                         (void)gpio_interrupt_deinit();
                         g_gpio_irq = NULL;
+                        g_gpio_irq_dio2 = NULL;
                         
                         return 1;
                     }
                     (void)gpio_interrupt_deinit();
                     g_gpio_irq = NULL;
+                    g_gpio_irq_dio2 = NULL;
                     
                     return 0;
                 }
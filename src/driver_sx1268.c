@@ -35,7 +35,6 @@
  */
 
 #include "driver_sx1268.h"
-#include <math.h>
 
 /**
  * @brief chip information definition
@@ -132,918 +131,5401 @@
 #define SX1268_REG_XTA_TRIM                              0x0911      /**< xta trim register */
 #define SX1268_REG_XTB_TRIM                              0x0912      /**< xtb trim register */
 #define SX1268_REG_DIO3_OUTPUT_CONTROL                   0x0920      /**< dio3 output voltage control register */
+#define SX1268_REG_RETENTION_LIST                        0x029F      /**< retention list register */
 #define SX1268_REG_EVENT_MASK                            0x0944      /**< event mask register */
 
 /**
- * @brief      read bytes
- * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  reg is the register address
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
- * @return     status code
- *             - 0 success
- *             - 1 spi read failed
- * @note       none
+ * @brief chip cached register list definition
+ * @note  registers changed by the chip itself like the rtc control, the trims, the dio3 output
+ *        control and the event mask are never cached
  */
-static uint8_t a_sx1268_spi_read(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static const uint16_t gs_cache_reg[SX1268_REGISTER_CACHE_SIZE] =
 {
-    if (handle->spi_write_read(&reg, 1, buf, len) != 0)   /* spi read */
-    {
-        return 1;                                         /* return error */
-    }
-    else
-    {
-        return 0;                                         /* success return 0 */
-    }
-}
+    SX1268_REG_DIOX_OUTPUT_ENABLE, SX1268_REG_DIOX_INPUT_ENABLE, SX1268_REG_DIOX_PULL_UP_CONTROL,
+    SX1268_REG_DIOX_PULL_DOWN_CONTROL, SX1268_REG_WHITENING_INIT_VALUE_MSB, SX1268_REG_WHITENING_INIT_VALUE_LSB,
+    SX1268_REG_CRC_INIT_VALUE_MSB, SX1268_REG_CRC_INIT_VALUE_LSB, SX1268_REG_CRC_POLYNOMIAL_VALUE_MSB,
+    SX1268_REG_CRC_POLYNOMIAL_VALUE_LSB, SX1268_REG_SYNC_WORD_0, SX1268_REG_SYNC_WORD_1,
+    SX1268_REG_SYNC_WORD_2, SX1268_REG_SYNC_WORD_3, SX1268_REG_SYNC_WORD_4,
+    SX1268_REG_SYNC_WORD_5, SX1268_REG_SYNC_WORD_6, SX1268_REG_SYNC_WORD_7,
+    SX1268_REG_NODE_ADDRESS, SX1268_REG_BROADCAST_ADDRESS, SX1268_REG_IQ_POLARITY_SETUP,
+    SX1268_REG_LORA_SYNC_WORD_MSB, SX1268_REG_LORA_SYNC_WORD_LSB, SX1268_REG_TX_MODULATION,
+    SX1268_REG_RX_GAIN, SX1268_REG_TX_CLAMP_CONFIG, SX1268_REG_OCP_CONFIGURATION,
+};
 
 /**
- * @brief     write bytes
+ * @brief     check command busy
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] reg is the register address
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
  * @return    status code
- *            - 0 success
- *            - 1 spi write failed
- *            - 2 len is over 383
- * @note      none
+ *            - 0 idle
+ *            - 1 busy or error
+ * @note      the busy pin is polled busy_spin times before yielding by busy_step_us,
+ *            the wait time is saved in busy_time_us and a sleeping chip is woken up first
  */
-static uint8_t a_sx1268_spi_write(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_sx1268_check_busy(sx1268_handle_t *handle)
 {
-    if (len > (384 - 1))                                              /* check the length */
+    uint8_t level;
+    uint8_t waited;
+    uint16_t spin;
+    uint32_t start;
+    uint32_t now;
+    uint32_t elapsed;
+    
+    if (handle->batch == 1)                                                 /* check batch */
     {
-        handle->debug_print("sx1268: len is over 383.\n");            /* len is over 383 */
+        return 0;                                                           /* the command is only recorded */
+    }
+    if (handle->state == SX1268_CHIP_STATE_SLEEP)                           /* if sleep */
+    {
+        uint8_t cmd;
+        uint8_t status;
         
-        return 2;                                                     /* return error */
+        cmd = SX1268_COMMAND_GET_STATUS;                                    /* get status */
+        if (handle->spi_write_read(&cmd, 1, &status, 1) != 0)               /* nss falling edge wakes the chip up */
+        {
+            return 1;                                                       /* return error */
+        }
+        handle->state = SX1268_CHIP_STATE_STANDBY_RC;                       /* the chip wakes up in standby rc */
     }
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 384);                    /* clear the buffer */
-    handle->buf[0] = reg;                                             /* set the reg */
-    memcpy(&handle->buf[1], buf, len);                                /* copy the buffer */
-    if (handle->spi_write_read(handle->buf, len + 1, NULL, 0) != 0)   /* spi write */
+    waited = 0;                                                             /* init 0 */
+    spin = 0;                                                               /* init 0 */
+    start = 0;                                                              /* init 0 */
+    now = 0;                                                                /* init 0 */
+    elapsed = 0;                                                            /* init 0 */
+    if (handle->get_time_us != NULL)                                        /* if get time */
     {
-        return 1;                                                     /* return error */
+        if (handle->get_time_us((uint32_t *)&start) != 0)                   /* get the start time */
+        {
+            return 1;                                                       /* return error */
+        }
     }
-    else
+    while (1)                                                               /* loop */
     {
-        return 0;                                                     /* success return 0 */
+        if (handle->busy_gpio_read((uint8_t *)&level) != 0)                 /* read busy gpio */
+        {
+            return 1;                                                       /* return error */
+        }
+        if ((waited != 0) && (handle->get_time_us != NULL))                 /* if waited with a timer */
+        {
+            if (handle->get_time_us((uint32_t *)&now) != 0)                 /* get the time */
+            {
+                return 1;                                                   /* return error */
+            }
+            elapsed = now - start;                                          /* get the elapsed time */
+        }
+        handle->busy_time_us = elapsed;                                     /* save the busy time */
+        if (elapsed > handle->busy_time_max_us)                             /* check the max */
+        {
+            handle->busy_time_max_us = elapsed;                             /* save the max */
+        }
+        if (level == 0)                                                     /* check level */
+        {
+            return 0;                                                       /* success return 0 */
+        }
+        if ((level != 1) || (elapsed >= handle->busy_timeout_us))           /* check level and timeout */
+        {
+            return 1;                                                       /* return error */
+        }
+        waited = 1;                                                         /* flag waited */
+        if (spin < handle->busy_spin)                                       /* spin first */
+        {
+            spin++;                                                         /* spin++ */
+            
+            continue;                                                       /* continue */
+        }
+        if (handle->delay_us != NULL)                                       /* if delay us */
+        {
+            handle->delay_us(handle->busy_step_us);                         /* yield step us */
+            if (handle->get_time_us == NULL)                                /* no timer */
+            {
+                elapsed += handle->busy_step_us;                            /* estimate the time */
+            }
+        }
+        else
+        {
+            handle->delay_ms(1);                                            /* yield 1 ms */
+            if (handle->get_time_us == NULL)                                /* no timer */
+            {
+                elapsed += 1000;                                            /* estimate the time */
+            }
+        }
     }
 }
 
 /**
- * @brief      read register bytes
- * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  reg is the register address
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
- * @return     status code
- *             - 0 success
- *             - 1 spi read register failed
- *             - 2 len is over 383
- * @note       none
+ * @brief     flush the batch commands
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      none
  */
-static uint8_t a_sx1268_spi_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_sx1268_batch_flush(sx1268_handle_t *handle)
 {
-    uint8_t reg_buf[3];
+    uint8_t i;
+    uint8_t res;
+    uint8_t batch;
     
-    if (len > (384 - 1))                                                            /* check the length */
+    if (handle->batch_num == 0)                                                                /* check the number */
     {
-        handle->debug_print("sx1268: len is over 383.\n");                          /* len is over 383 */
-        
-        return 2;                                                                   /* return error */
+        return 0;                                                                              /* success return 0 */
     }
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 384);                                  /* clear the buffer */
-    reg_buf[0] = SX1268_COMMAND_READ_REGISTER;                                      /* set the command */
-    reg_buf[1] = (reg >> 8) & 0xFF;                                                 /* set msb */
-    reg_buf[2] = (reg >> 0) & 0xFF;                                                 /* set lsb */
-    if (handle->spi_write_read((uint8_t *)reg_buf, 3, handle->buf, len + 1) != 0)   /* spi read */
+    batch = handle->batch;                                                                     /* save the batch flag */
+    handle->batch = 0;                                                                         /* stop recording */
+    res = 0;                                                                                   /* init 0 */
+    if (a_sx1268_check_busy(handle) != 0)                                                      /* check busy */
     {
-        return 1;                                                                   /* return error */
+        res = 1;                                                                               /* flag error */
+    }
+    else if (handle->spi_writev != NULL)                                                       /* if spi writev */
+    {
+        handle->batch_seg[handle->batch_num - 1].cs_change = 0;                                /* keep the last cs normal */
+        if (handle->spi_writev(handle->batch_seg, handle->batch_num) != 0)                     /* spi writev */
+        {
+            res = 1;                                                                           /* flag error */
+        }
     }
     else
     {
-        memcpy(buf, handle->buf + 1, len);                                          /* copy the data */
-        
-        return 0;                                                                   /* success return 0 */
+        for (i = 0; i < handle->batch_num; i++)                                                /* run all commands */
+        {
+            if ((i != 0) && (a_sx1268_check_busy(handle) != 0))                               /* check busy */
+            {
+                res = 1;                                                                       /* flag error */
+                
+                break;                                                                         /* break */
+            }
+            if (handle->spi_write_read(handle->batch_seg[i].tx_buf, 
+                                       handle->batch_seg[i].len, NULL, 0) != 0)                /* spi write */
+            {
+                res = 1;                                                                       /* flag error */
+                
+                break;                                                                         /* break */
+            }
+        }
+    }
+    if ((res == 0) && (a_sx1268_check_busy(handle) != 0))                                      /* wait for the last command */
+    {
+        res = 1;                                                                               /* flag error */
     }
+    if (res != 0)                                                                              /* check the result */
+    {
+        handle->reg_cache_valid = 0;                                                           /* drop the register cache */
+        handle->config_valid = 0;                                                              /* drop the configuration shadow */
+    }
+    handle->batch_num = 0;                                                                     /* clear the number */
+    handle->batch_len = 0;                                                                     /* clear the length */
+    handle->batch = batch;                                                                     /* restore the batch flag */
+    
+    return res;                                                                                /* return the result */
 }
 
 /**
- * @brief     write register bytes
+ * @brief     add a command to the batch
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] reg is the register address
+ * @param[in] *header points to a header buffer
+ * @param[in] header_len is the header length
  * @param[in] *buf points to a data buffer
  * @param[in] len is the data length
  * @return    status code
  *            - 0 success
- *            - 1 spi write register failed
- *            - 2 len is over 381
+ *            - 1 add failed
+ *            - 2 len is over the batch buffer size
  * @note      none
  */
-static uint8_t a_sx1268_spi_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_sx1268_batch_add(sx1268_handle_t *handle, uint8_t *header, uint16_t header_len,
+                                  uint8_t *buf, uint16_t len)
 {
-    if (len > (384 - 3))                                              /* check the length */
+    sx1268_spi_segment_t *seg;
+    
+    if ((header_len + len) > SX1268_BATCH_BUFFER_SIZE)                                         /* check the length */
     {
-        handle->debug_print("sx1268: len is over 381.\n");            /* len is over 381 */
+        handle->debug_print("sx1268: len is over the batch buffer size.\n");                   /* len is over the batch buffer size */
         
-        return 2;                                                     /* return error */
+        return 2;                                                                              /* return error */
+    }
+    if ((handle->batch_num >= SX1268_BATCH_MAX_NUM) || 
+        ((handle->batch_len + header_len + len) > SX1268_BATCH_BUFFER_SIZE))                   /* check the free space */
+    {
+        if (a_sx1268_batch_flush(handle) != 0)                                                 /* flush the batch */
+        {
+            return 1;                                                                          /* return error */
+        }
     }
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 384);                    /* clear the buffer */
-    handle->buf[0] = SX1268_COMMAND_WRITE_REGISTER;                   /* set the commmand */
-    handle->buf[1] = (reg >> 8) & 0xFF;                               /* set reg msb */
-    handle->buf[2] = (reg >> 0) & 0xFF;                               /* set reg lsb */
-    memcpy(&handle->buf[3], buf, len);                                /* copy the buffer */
-    if (handle->spi_write_read(handle->buf, len + 3, NULL, 0) != 0)   /* spi write */
+    seg = &handle->batch_seg[handle->batch_num];                                               /* get the segment */
+    seg->tx_buf = &handle->batch_buf[handle->batch_len];                                       /* set the tx buffer */
+    seg->rx_buf = NULL;                                                                        /* no rx */
+    seg->len = header_len + len;                                                               /* set the length */
+    seg->cs_change = 1;                                                                        /* one command per cs cycle */
+    seg->delay_us = handle->batch_gap_us;                                                      /* set the gap */
+    memcpy(seg->tx_buf, header, header_len);                                                   /* copy the header */
+    if (len != 0)                                                                              /* check the length */
     {
-        return 1;                                                     /* return error */
+        memcpy(seg->tx_buf + header_len, buf, len);                                            /* copy the data */
     }
-    else
+    handle->batch_len += header_len + len;                                                     /* add the length */
+    handle->batch_num++;                                                                       /* add the number */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the register cache
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] len is the register length
+ * @note      none
+ */
+static void a_sx1268_cache_invalidate(sx1268_handle_t *handle, uint16_t reg, uint16_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                     /* check all registers */
     {
-        return 0;                                                     /* success return 0 */
+        if ((gs_cache_reg[i] >= reg) && (gs_cache_reg[i] < (reg + len)))                 /* check the range */
+        {
+            handle->reg_cache_valid &= ~((uint32_t)1 << i);                              /* clear the valid bit */
+            handle->reg_cache_lost &= ~((uint32_t)1 << i);                               /* clear the lost bit */
+        }
     }
 }
 
 /**
- * @brief     write buffer
+ * @brief     write the register cache
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] offset is the buffer offset
+ * @param[in] reg is the register address
  * @param[in] *buf points to a data buffer
  * @param[in] len is the data length
- * @return    status code
- *            - 0 success
- *            - 1 spi write buffer failed
- *            - 2 len is over 382
  * @note      none
  */
-static uint8_t a_sx1268_spi_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+static void a_sx1268_cache_write(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    if (len > (384 - 2))                                              /* check the length */
-    {
-        handle->debug_print("sx1268: len is over 382.\n");            /* len is over 382 */
-        
-        return 2;                                                     /* return error */
-    }
+    uint8_t i;
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 384);                    /* clear the buffer */
-    handle->buf[0] = SX1268_COMMAND_WRITE_BUFFER;                     /* set the commmand */
-    handle->buf[1] = offset;                                          /* set reg msb */
-    memcpy(&handle->buf[2], buf, len);                                /* copy the buffer */
-    if (handle->spi_write_read(handle->buf, len + 2, NULL, 0) != 0)   /* spi write */
+    if (handle->reg_cache_enable == 0)                                                   /* check the cache */
     {
-        return 1;                                                     /* return error */
+        return;                                                                          /* return */
     }
-    else
+    for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                     /* check all registers */
     {
-        return 0;                                                     /* success return 0 */
+        if ((gs_cache_reg[i] >= reg) && (gs_cache_reg[i] < (reg + len)))                 /* check the range */
+        {
+            handle->reg_cache[i] = buf[gs_cache_reg[i] - reg];                           /* save the value */
+            handle->reg_cache_valid |= (uint32_t)1 << i;                                 /* set the valid bit */
+            handle->reg_cache_lost &= ~((uint32_t)1 << i);                               /* clear the lost bit */
+        }
     }
 }
 
 /**
- * @brief      read buffer
+ * @brief      read the register cache
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  offset is the buffer offset
+ * @param[in]  reg is the register address
  * @param[out] *buf points to a data buffer
  * @param[in]  len is the data length
  * @return     status code
  *             - 0 success
- *             - 1 spi read buffer failed
- *             - 2 len is over 383
- * @note      none
+ *             - 1 not cached
+ * @note       none
  */
-static uint8_t a_sx1268_spi_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+static uint8_t a_sx1268_cache_read(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
 {
-    uint8_t reg_buf[2];
-    
-    if (len > (384 - 1))                                                            /* check the length */
-    {
-        handle->debug_print("sx1268: len is over 383.\n");                          /* len is over 383 */
-        
-        return 2;                                                                   /* return error */
-    }
+    uint8_t i;
+    uint16_t j;
+    uint16_t found;
     
-    memset(handle->buf, 0, sizeof(uint8_t) * 384);                                  /* clear the buffer */
-    reg_buf[0] = SX1268_COMMAND_READ_BUFFER ;                                       /* set the command */
-    reg_buf[1] = offset;                                                            /* set msb */
-    if (handle->spi_write_read((uint8_t *)reg_buf, 2, handle->buf, len + 1) != 0)   /* spi write */
+    if ((handle->reg_cache_enable == 0) || (len == 0))                                   /* check the cache */
     {
-        return 1;                                                                   /* return error */
+        return 1;                                                                        /* return error */
     }
-    else
+    for (j = 0; j < len; j++)                                                            /* check all addresses */
     {
-        memcpy(buf, handle->buf + 1, len);                                          /* copy the data */
-        
-        return 0;                                                                   /* success return 0 */
+        found = 0;                                                                       /* init 0 */
+        for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                 /* find the register */
+        {
+            if ((gs_cache_reg[i] == (reg + j)) && 
+                ((handle->reg_cache_valid & ((uint32_t)1 << i)) != 0))                   /* check the valid bit */
+            {
+                buf[j] = handle->reg_cache[i];                                           /* get the value */
+                found = 1;                                                               /* flag found */
+                
+                break;                                                                   /* break */
+            }
+        }
+        if (found == 0)                                                                  /* check found */
+        {
+            return 1;                                                                    /* return error */
+        }
     }
+    
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     check command busy
- * @param[in] *handle points to a sx1268 handle structure
- * @return    status code
- *            - 0 idle
- *            - 1 busy or error
+ * @brief     get the configuration shadow index
+ * @param[in] reg is the command
+ * @return    shadow index, SX1268_CONFIG_SHADOW_NUM if not shadowed
  * @note      none
  */
-static uint8_t a_sx1268_check_busy(sx1268_handle_t *handle)
+static uint8_t a_sx1268_config_index(uint8_t reg)
 {
-    uint8_t level;
-    uint8_t timeout;
-    
-    timeout = 100;                                            /* set max 100 */
-    
-    while (1)                                                 /* loop */
+    switch (reg)
     {
-        if (handle->busy_gpio_read((uint8_t *)&level) != 0)   /* read busy gpio */
+        case SX1268_COMMAND_SET_MODULATION_PARAMS :
         {
-             return 1;                                        /* return error */
+            return 0;                                                                    /* modulation params */
         }
-        else
+        case SX1268_COMMAND_SET_PACKET_PARAMS :
         {
-            if (level == 0)                                   /* check level */
-            {
-                return 0;                                     /* success return 0 */
-            }
-            else if ((level == 1) && (timeout != 0))          /* check level and timeout */
-            {
-                handle->delay_ms(10);                         /* delay 10 ms */
-                timeout--;                                    /* timeout-- */
-                if (timeout != 0)                             /* check timeout */
-                {
-                    continue;                                 /* continue */
-                }
-                else
-                {
-                    return 1;                                 /* return error */
-                }
-            }
-            else
-            {
-                return 1;                                     /* return error */
-            }
+            return 1;                                                                    /* packet params */
+        }
+        case SX1268_COMMAND_SET_RF_FREQUENCY :
+        {
+            return 2;                                                                    /* rf frequency */
+        }
+        case SX1268_COMMAND_SET_TX_PARAMS :
+        {
+            return 3;                                                                    /* tx params */
+        }
+        case SX1268_COMMAND_SET_BUFFER_BASE_ADDRESS :
+        {
+            return 4;                                                                    /* buffer base address */
+        }
+        default :
+        {
+            return SX1268_CONFIG_SHADOW_NUM;                                             /* not shadowed */
         }
     }
 }
 
 /**
- * @brief     irq handler
+ * @brief     check if a command is unchanged
  * @param[in] *handle points to a sx1268 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 run failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @param[in] reg is the command
+ * @param[in] *buf points to a param buffer
+ * @param[in] len is the param length
+ * @return    1 if the command can be skipped, otherwise 0
  * @note      none
  */
-uint8_t sx1268_irq_handler(sx1268_handle_t *handle)
+static uint8_t a_sx1268_config_unchanged(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    uint8_t res;
-    uint8_t buf[3]; 
-    uint16_t status;
+    uint8_t index;
     
-    if (handle == NULL)                                                                                        /* check handle */
+    if ((handle->config_diff == 0) || (handle->config_force != 0) || 
+        ((handle->capture != 0) && (handle->irq_active == 0)))                           /* check the flag */
     {
-        return 2;                                                                                              /* return error */
+        return 0;                                                                        /* send it */
     }
-    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    if (reg == SX1268_COMMAND_SET_STANDBY)                                               /* standby */
     {
-        return 3;                                                                                              /* return error */
+        if (len == 0)                                                                    /* check the length */
+        {
+            return 0;                                                                    /* send it */
+        }
+        
+        return (((buf[0] == 0) && (handle->state == SX1268_CHIP_STATE_STANDBY_RC)) ||
+                ((buf[0] != 0) && (handle->state == SX1268_CHIP_STATE_STANDBY_XOSC))) ? 1 : 0; /* check the state */
     }
-    
-    memset(buf, 0, sizeof(uint8_t) * 3);                                                                       /* clear the buffer */
-    res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_IRQ_STATUS, (uint8_t *)buf, 3);                         /* read command */
-    if (res != 0)                                                                                              /* check result */
+    index = a_sx1268_config_index(reg);                                                  /* get the index */
+    if ((index >= SX1268_CONFIG_SHADOW_NUM) || 
+        ((handle->config_valid & (1 << index)) == 0) ||
+        (handle->config_len[index] != len))                                              /* check the shadow */
     {
-        handle->debug_print("sx1268: get irq status failed.\n");                                               /* get irq status failed */
-       
-        return 1;                                                                                              /* return error */
+        return 0;                                                                        /* send it */
     }
-    status = ((uint16_t)buf[1] << 8) | buf[2];                                                                 /* set status */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)&buf[1], 2);                  /* write command */
-    if (res != 0)                                                                                              /* check result */
-    {
-        handle->debug_print("sx1268: clear irq status failed.\n");                                             /* clear irq status failed */
-       
-        return 1;                                                                                              /* return error */
+    
+    return (memcmp(handle->config_shadow[index], buf, len) == 0) ? 1 : 0;                /* compare the params */
+}
+
+/**
+ * @brief     save or drop the configuration shadow
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the command
+ * @param[in] *buf points to a param buffer
+ * @param[in] len is the param length
+ * @param[in] valid is the applied flag
+ * @note      none
+ */
+static void a_sx1268_config_save(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len, uint8_t valid)
+{
+    uint8_t index;
+    
+    index = a_sx1268_config_index(reg);                                                  /* get the index */
+    if (index >= SX1268_CONFIG_SHADOW_NUM)                                               /* check the index */
+    {
+        return;                                                                          /* return */
+    }
+    if ((valid == 0) || (len > SX1268_CONFIG_SHADOW_SIZE))                               /* check the param */
+    {
+        handle->config_valid &= ~(1 << index);                                           /* drop the shadow */
+        
+        return;                                                                          /* return */
     }
+    memcpy(handle->config_shadow[index], buf, len);                                      /* save the params */
+    handle->config_len[index] = (uint8_t)len;                                            /* save the length */
+    handle->config_valid |= (1 << index);                                                /* set the valid bit */
+}
+
+/**
+ * @brief     check if cached registers already hold the data
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    1 if the write can be skipped, otherwise 0
+ * @note      none
+ */
+static uint8_t a_sx1268_cache_unchanged(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint16_t j;
+    uint8_t found;
     
-    handle->crc_error = 0;                                                                                     /* clear crc error */
-    if ((status & SX1268_IRQ_PREAMBLE_DETECTED) != 0)                                                          /* if preamble detected */
+    if ((handle->config_diff == 0) || (handle->config_force != 0) || 
+        (handle->reg_cache_enable == 0) || (len == 0) || 
+        ((handle->capture != 0) && (handle->irq_active == 0)))                           /* check the flag */
     {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
-        {
-            handle->receive_callback(SX1268_IRQ_PREAMBLE_DETECTED, NULL, 0);                                   /* run callback */
-        }
+        return 0;                                                                        /* write it */
     }
-    if ((status & SX1268_IRQ_SYNC_WORD_VALID) != 0)                                                            /* if valid sync word detected */
+    for (j = 0; j < len; j++)                                                            /* check all addresses */
     {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        found = 0;                                                                       /* init 0 */
+        for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                 /* find the register */
         {
-            handle->receive_callback(SX1268_IRQ_SYNC_WORD_VALID, NULL, 0);                                     /* run callback */
+            if ((gs_cache_reg[i] == (reg + j)) && 
+                ((handle->reg_cache_valid & ((uint32_t)1 << i)) != 0) &&
+                (handle->reg_cache[i] == buf[j]))                                        /* check the value */
+            {
+                found = 1;                                                               /* flag found */
+                
+                break;                                                                   /* break */
+            }
         }
-    }
-    if ((status & SX1268_IRQ_HEADER_VALID) != 0)                                                               /* if valid header */
-    {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        if (found == 0)                                                                  /* check found */
         {
-            handle->receive_callback(SX1268_IRQ_HEADER_VALID, NULL, 0);                                        /* run callback */
+            return 0;                                                                    /* write it */
         }
     }
-    if ((status & SX1268_IRQ_HEADER_ERR) != 0)                                                                 /* if header error */
-    {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+    
+    return 1;                                                                            /* skip it */
+}
+
+/**
+ * @brief     check if a command is part of the configuration
+ * @param[in] reg is the command
+ * @return    1 if the command is a configuration command, otherwise 0
+ * @note      none
+ */
+static uint8_t a_sx1268_config_command(uint8_t reg)
+{
+    switch (reg)
+    {
+        case SX1268_COMMAND_SET_PACKET_TYPE :
+        case SX1268_COMMAND_SET_MODULATION_PARAMS :
+        case SX1268_COMMAND_SET_PACKET_PARAMS :
+        case SX1268_COMMAND_SET_RF_FREQUENCY :
+        case SX1268_COMMAND_SET_PA_CONFIG :
+        case SX1268_COMMAND_SET_TX_PARAMS :
+        case SX1268_COMMAND_SET_DIO_IRQ_PARAMS :
+        case SX1268_COMMAND_SET_BUFFER_BASE_ADDRESS :
+        case SX1268_COMMAND_SET_REGULATOR_MODE :
+        case SX1268_COMMAND_SET_CALIBRATE :
+        case SX1268_COMMAND_SET_CALIBRATE_IMAGE :
+        case SX1268_COMMAND_SET_DIO2_AS_RF_SWITCH_CTRL :
+        case SX1268_COMMAND_SET_DIO3_AS_TCXO_CTRL :
+        case SX1268_COMMAND_SET_RX_TX_FALLBACK_MODE :
+        case SX1268_COMMAND_SET_CAD_PARAMS :
+        case SX1268_COMMAND_SET_LORA_SYMB_NUM_TIMEOUT :
+        case SX1268_COMMAND_STOP_TIMER_ON_PREAMBLE :
+        case SX1268_COMMAND_WRITE_REGISTER :
+        {
+            return 1;                                                                    /* configuration */
+        }
+        default :
         {
-            handle->receive_callback(SX1268_IRQ_HEADER_ERR, NULL, 0);                                          /* run callback */
+            return 0;                                                                    /* not configuration */
         }
     }
-    if ((status & SX1268_IRQ_CRC_ERR) != 0)                                                                    /* if crc error */
+}
+
+/**
+ * @brief     check if a new configuration entry supersedes a captured one
+ * @param[in] *entry points to a captured entry
+ * @param[in] reg is the command
+ * @param[in] *header points to a header buffer
+ * @param[in] header_len is the header length
+ * @param[in] len is the param length
+ * @return    1 if the captured entry can be dropped, otherwise 0
+ * @note      a register write supersedes an older one only when it covers all of its bytes
+ */
+static uint8_t a_sx1268_config_supersede(uint8_t *entry, uint8_t reg, uint8_t *header, uint8_t header_len,
+                                         uint16_t len)
+{
+    uint16_t old_addr;
+    uint16_t new_addr;
+    
+    if (entry[0] != reg)                                                                 /* check the command */
+    {
+        return 0;                                                                        /* keep it */
+    }
+    if (header_len != 2)                                                                 /* not a register write */
+    {
+        return 1;                                                                        /* the same command replaces it */
+    }
+    old_addr = ((uint16_t)entry[2] << 8) | entry[3];                                     /* get the old address */
+    new_addr = ((uint16_t)header[0] << 8) | header[1];                                   /* get the new address */
+    
+    return ((new_addr <= old_addr) && 
+            ((uint32_t)new_addr + len >= (uint32_t)old_addr + (entry[1] - 2))) ? 1 : 0; /* check the covered range */
+}
+
+/**
+ * @brief     capture a configuration command
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the command
+ * @param[in] *header points to a header buffer
+ * @param[in] header_len is the header length
+ * @param[in] *buf points to a param buffer
+ * @param[in] len is the param length
+ * @note      the header is the register address of a write register command,
+ *            entries are kept in bus order and older entries that the new one fully
+ *            overwrites are dropped, commands sent by the irq handler are not captured
+ */
+static void a_sx1268_config_capture(sx1268_handle_t *handle, uint8_t reg, uint8_t *header, uint8_t header_len,
+                                    uint8_t *buf, uint16_t len)
+{
+    uint8_t *entry;
+    uint16_t pos;
+    uint16_t size;
+    
+    if ((handle->capture == 0) || (handle->irq_active != 0) || 
+        (a_sx1268_config_command(reg) == 0))                                             /* check the capture */
     {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        return;                                                                          /* return */
+    }
+    if ((header_len + len) > 255)                                                        /* check the length */
+    {
+        handle->capture_overflow = 1;                                                    /* flag overflow */
+        
+        return;                                                                          /* return */
+    }
+    
+    pos = 0;                                                                             /* init 0 */
+    while (pos < handle->capture_len)                                                    /* find superseded entries */
+    {
+        entry = &handle->capture_buf[pos];                                               /* get the entry */
+        size = 2 + entry[1];                                                             /* get the entry size */
+        if (a_sx1268_config_supersede(entry, reg, header, header_len, len) != 0)         /* check the entry */
         {
-            handle->receive_callback(SX1268_IRQ_CRC_ERR, NULL, 0);                                             /* run callback */
+            memmove(entry, entry + size, handle->capture_len - pos - size);              /* drop the entry */
+            handle->capture_len -= size;                                                 /* sub the length */
+        }
+        else
+        {
+            pos += size;                                                                 /* next entry */
         }
-        handle->crc_error = 1;                                                                                 /* set crc error */
     }
-    if ((status & SX1268_IRQ_CAD_DONE) != 0)                                                                   /* if cad done */
+    if ((handle->capture_len + 2 + header_len + len) > handle->capture_size)             /* check the free space */
+    {
+        handle->capture_overflow = 1;                                                    /* flag overflow */
+        
+        return;                                                                          /* return */
+    }
+    entry = &handle->capture_buf[handle->capture_len];                                   /* get the entry */
+    entry[0] = reg;                                                                      /* set the command */
+    entry[1] = (uint8_t)(header_len + len);                                              /* set the length */
+    memcpy(&entry[2], header, header_len);                                               /* copy the header */
+    memcpy(&entry[2 + header_len], buf, len);                                            /* copy the params */
+    handle->capture_len += 2 + header_len + len;                                         /* add the length */
+}
+
+/**
+ * @brief     save the status byte
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] status is the status byte
+ * @note      none
+ */
+static void a_sx1268_save_status(sx1268_handle_t *handle, uint8_t status)
+{
+    uint8_t cmd_status;
+    
+    handle->status = status;                                                 /* save the status */
+    cmd_status = (status >> 1) & 0x07;                                       /* get the command status */
+    if ((cmd_status == SX1268_COMMAND_STATUS_TIMEOUT) || 
+        (cmd_status == SX1268_COMMAND_STATUS_PROCESSING_ERROR) ||
+        (cmd_status == SX1268_COMMAND_STATUS_EXECUTE_FAILURE))               /* check the command status */
+    {
+        handle->command_error_cnt++;                                         /* command error counter++ */
+    }
+}
+
+/**
+ * @brief     mark a register lost after a warm start
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @note      the cached value is kept so that it can be restored
+ */
+static void a_sx1268_cache_lose(sx1268_handle_t *handle, uint16_t reg)
+{
+    uint8_t i;
+    
+    for (i = 0; i < handle->retention_num; i++)                                          /* check the retention list */
     {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        if (handle->retention_reg[i] == reg)                                             /* check the register */
         {
-            handle->receive_callback(SX1268_IRQ_CAD_DONE, NULL, 0);                                            /* run callback */
+            return;                                                                      /* retained */
         }
-        handle->cad_done = 1;                                                                                  /* set cad done */
     }
-    if ((status & SX1268_IRQ_CAD_DETECTED) != 0)                                                               /* if cad detected */
+    for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                     /* find the register */
     {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        if (gs_cache_reg[i] == reg)                                                      /* check the register */
         {
-            handle->receive_callback(SX1268_IRQ_CAD_DETECTED, NULL, 0);                                        /* run callback */
+            if ((handle->reg_cache_valid & ((uint32_t)1 << i)) != 0)                     /* check the valid bit */
+            {
+                handle->reg_cache_valid &= ~((uint32_t)1 << i);                          /* clear the valid bit */
+                handle->reg_cache_lost |= (uint32_t)1 << i;                              /* set the lost bit */
+            }
+            
+            return;                                                                      /* return */
         }
-        handle->cad_detected = 1;                                                                              /* set detected */
     }
-    if ((status & SX1268_IRQ_TIMEOUT) != 0)                                                                    /* if timeout */
+}
+
+/**
+ * @brief     update the chip state
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the command
+ * @param[in] *buf points to a param buffer
+ * @param[in] len is the param length
+ * @note      none
+ */
+static void a_sx1268_update_state(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    switch (reg)
     {
-        uint8_t control;
-        uint8_t mask;
-        
-        control = 0x00;
-        res = a_sx1268_spi_write_register(handle, SX1268_REG_DIO3_OUTPUT_CONTROL, (uint8_t *)&control, 1);     /* write register */
-        if (res != 0)                                                                                          /* check result */
+        case SX1268_COMMAND_SET_SLEEP :
         {
-            handle->debug_print("sx1268: write register failed.\n");                                           /* write register failed */
-           
-            return 1;                                                                                          /* return error */
+            handle->state = SX1268_CHIP_STATE_SLEEP;                                          /* sleep */
+            if ((len > 0) && ((buf[0] & (1 << 2)) != 0))                                     /* warm start */
+            {
+                a_sx1268_cache_lose(handle, SX1268_REG_RX_GAIN);                              /* retained only if listed */
+                a_sx1268_cache_lose(handle, SX1268_REG_TX_CLAMP_CONFIG);                      /* retained only if listed */
+                a_sx1268_cache_lose(handle, SX1268_REG_OCP_CONFIGURATION);                    /* retained only if listed */
+            }
+            else
+            {
+                handle->reg_cache_valid = 0;                                                  /* cold start loses all */
+                handle->reg_cache_lost = 0;                                                   /* nothing to restore */
+                handle->retention_num = 0;                                                    /* cold start loses the list */
+                handle->config_valid = 0;                                                     /* cold start loses all */
+                handle->tx_base = 0x00;                                                       /* cold start resets the base */
+                handle->rx_base = 0x00;                                                       /* cold start resets the base */
+                handle->packet_type = SX1268_PACKET_TYPE_GFSK;                                /* cold start resets the type */
+            }
+            
+            break;
         }
-        
-        /* read mask */
-        res = a_sx1268_spi_read_register(handle, SX1268_REG_EVENT_MASK, (uint8_t *)&mask, 1);                  /* read register */
-        if (res != 0)                                                                                          /* check result */
+        case SX1268_COMMAND_SET_PACKET_TYPE :
         {
-            handle->debug_print("sx1268: read register failed.\n");                                            /* read register failed */
-           
-            return 1;                                                                                          /* return error */
+            handle->config_valid &= ~((1 << 0) | (1 << 1));                                   /* modulation and packet params are reset */
+            if (len > 0)                                                                      /* check length */
+            {
+                handle->packet_type = buf[0];                                                 /* save packet type */
+            }
+            
+            break;
         }
-        mask |= 0x02;                                                                                          /* set mask */
-        res = a_sx1268_spi_write_register(handle, SX1268_REG_EVENT_MASK, (uint8_t *)&mask, 1);                 /* write register */
-        if (res != 0)                                                                                          /* check result */
+        case SX1268_COMMAND_SET_PA_CONFIG :
         {
-            handle->debug_print("sx1268: write register failed.\n");                                           /* write register failed */
-           
-            return 1;                                                                                          /* return error */
+            a_sx1268_cache_invalidate(handle, SX1268_REG_OCP_CONFIGURATION, 1);               /* ocp is reset by the pa config */
+            
+            break;
         }
-        
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        case SX1268_COMMAND_SET_BUFFER_BASE_ADDRESS :
         {
-            handle->receive_callback(SX1268_IRQ_TIMEOUT, NULL, 0);                                             /* run callback */
+            if (len >= 2)                                                                     /* check length */
+            {
+                handle->tx_base = buf[0];                                                     /* save tx base address */
+                handle->rx_base = buf[1];                                                     /* save rx base address */
+            }
+            
+            break;
         }
-        handle->timeout = 1;                                                                                   /* flag timeout */
-    }
-    if ((status & SX1268_IRQ_TX_DONE) != 0)                                                                    /* if tx done */
-    {
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        case SX1268_COMMAND_SET_DIO_IRQ_PARAMS :
         {
-            handle->receive_callback(SX1268_IRQ_TX_DONE, NULL, 0);                                             /* run callback */
+            if (len >= 8)                                                                     /* check length */
+            {
+                handle->irq_mask = ((uint16_t)buf[0] << 8) | buf[1];                          /* save irq mask */
+                handle->irq_line_mask[0] = ((uint16_t)buf[2] << 8) | buf[3];                  /* save dio1 mask */
+                handle->irq_line_mask[1] = ((uint16_t)buf[4] << 8) | buf[5];                  /* save dio2 mask */
+                handle->irq_line_mask[2] = ((uint16_t)buf[6] << 8) | buf[7];                  /* save dio3 mask */
+            }
+            
+            break;
         }
-        handle->tx_done = 1;                                                                                   /* flag tx done */
-    }
-    if ((status & SX1268_IRQ_RX_DONE) != 0)                                                                    /* if rx done */
-    {
-        uint8_t payload_length_rx;
-        uint8_t rx_start_buffer_pointer;
-        
-        memset(buf, 0, sizeof(uint8_t) * 3);                                                                   /* clear the buffer */
-        res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_RX_BUFFER_STATUS, (uint8_t *)buf, 3);               /* read command */
-        if (res != 0)                                                                                          /* check result */
+        case SX1268_COMMAND_SET_STANDBY :
         {
-            handle->debug_print("sx1268: get rx buffer status failed.\n");                                     /* get rx buffer status failed */
-           
-            return 1;                                                                                          /* return error */
+            if ((len > 0) && (buf[0] != 0))                                                   /* check the clock source */
+            {
+                handle->state = SX1268_CHIP_STATE_STANDBY_XOSC;                               /* standby xosc */
+            }
+            else
+            {
+                handle->state = SX1268_CHIP_STATE_STANDBY_RC;                                 /* standby rc */
+            }
+            
+            break;
         }
-        payload_length_rx = buf[1];                                                                            /* set status */
-        rx_start_buffer_pointer = buf[2];                                                                      /* set status */
-        
-        res = a_sx1268_spi_read_buffer(handle, rx_start_buffer_pointer, handle->receive_buf,
-                                       payload_length_rx);                                                     /* read buffer */
-        if (res != 0)                                                                                          /* check result */
+        case SX1268_COMMAND_SET_FS :
         {
-            handle->debug_print("sx1268: read buffer failed.\n");                                              /* read buffer failed */
-           
-            return 1;                                                                                          /* return error */
+            handle->state = SX1268_CHIP_STATE_FS;                                             /* fs */
+            
+            break;
+        }
+        case SX1268_COMMAND_SET_TX :
+        case SX1268_COMMAND_SET_TX_CONTINUOUS_WAVE :
+        case SX1268_COMMAND_SET_TX_INFINITE_PREAMBLE :
+        {
+            handle->state = SX1268_CHIP_STATE_TX;                                             /* tx */
+            
+            break;
+        }
+        case SX1268_COMMAND_SET_RX :
+        {
+            handle->state = SX1268_CHIP_STATE_RX;                                             /* rx */
+            handle->rx_continuous = ((len >= 3) && (buf[0] == 0xFF) && 
+                                     (buf[1] == 0xFF) && (buf[2] == 0xFF)) ? 1 : 0;            /* set continuous */
+            
+            break;
+        }
+        case SX1268_COMMAND_SET_RX_DUTY_CYCLE :
+        {
+            handle->state = SX1268_CHIP_STATE_RX;                                             /* rx */
+            handle->rx_continuous = 1;                                                        /* set continuous */
+            
+            break;
+        }
+        case SX1268_COMMAND_SET_CAD :
+        {
+            handle->state = SX1268_CHIP_STATE_CAD;                                            /* cad */
+            
+            break;
         }
-        if (handle->receive_callback != NULL)                                                                  /* if receive callback */
+        case SX1268_COMMAND_SET_RX_TX_FALLBACK_MODE :
         {
-            if (handle->crc_error == 0)                                                                        /* check crc error */
+            if (len > 0)                                                                      /* check the length */
             {
-                handle->receive_callback(SX1268_IRQ_RX_DONE, handle->receive_buf, payload_length_rx);          /* run callback */
+                if (buf[0] == SX1268_RX_TX_FALLBACK_MODE_FS)                                  /* fs */
+                {
+                    handle->fallback_state = SX1268_CHIP_STATE_FS;                            /* set fs */
+                }
+                else if (buf[0] == SX1268_RX_TX_FALLBACK_MODE_STDBY_XOSC)                     /* standby xosc */
+                {
+                    handle->fallback_state = SX1268_CHIP_STATE_STANDBY_XOSC;                  /* set standby xosc */
+                }
+                else
+                {
+                    handle->fallback_state = SX1268_CHIP_STATE_STANDBY_RC;                    /* set standby rc */
+                }
             }
-            else
+            
+            break;
+        }
+        case SX1268_COMMAND_SET_CAD_PARAMS :
+        {
+            if (len >= 4)                                                                     /* check the length */
             {
-                handle->receive_callback(SX1268_IRQ_RX_DONE, NULL, 0);                                         /* run callback */
+                handle->cad_exit_rx = (buf[3] == SX1268_LORA_CAD_EXIT_MODE_RX) ? 1 : 0;       /* set cad exit mode */
             }
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief      read bytes
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 spi read failed
+ * @note       none
+ */
+static uint8_t a_sx1268_spi_read(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if (handle->batch_num != 0)                           /* check the batch */
+    {
+        if (a_sx1268_batch_flush(handle) != 0)            /* flush the batch */
+        {
+            return 1;                                     /* return error */
         }
     }
     
-    return 0;                                                                                                  /* success return 0 */
+    if (handle->spi_write_read(&reg, 1, buf, len) != 0)   /* spi read */
+    {
+        return 1;                                         /* return error */
+    }
+    else
+    {
+        if (len != 0)                                     /* check the length */
+        {
+            a_sx1268_save_status(handle, buf[0]);         /* save the status */
+        }
+        
+        return 0;                                         /* success return 0 */
+    }
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     write bytes
  * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
  * @return    status code
  *            - 0 success
- *            - 1 spi initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 reset gpio initialization failed
- *            - 5 busy gpio initialization failed
- *            - 6 reset chip failed
+ *            - 1 spi write failed
+ *            - 2 len is over 383
  * @note      none
  */
-uint8_t sx1268_init(sx1268_handle_t *handle)
+static uint8_t a_sx1268_spi_write(sx1268_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    uint8_t buf[2];
-    uint8_t prev;
+    uint8_t res;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (len > (384 - 1))                                              /* check the length */
     {
-        return 2;                                                                          /* return error */
+        handle->debug_print("sx1268: len is over 383.\n");            /* len is over 383 */
+        
+        return 2;                                                     /* return error */
     }
-    if (handle->debug_print == NULL)                                                       /* check debug_print */
+    if (a_sx1268_config_unchanged(handle, reg, buf, len) != 0)        /* check the configuration */
     {
-        return 3;                                                                          /* return error */
+        return 0;                                                     /* skip the unchanged command */
     }
-    if (handle->spi_init == NULL)                                                          /* check spi_init */
+    
+    if (handle->batch == 1)                                           /* if batch */
     {
-        handle->debug_print("sx1268: spi_init is null.\n");                                /* spi_init is null */
-       
-        return 3;                                                                          /* return error */
+        res = a_sx1268_batch_add(handle, &reg, 1, buf, len);          /* add to the batch */
     }
-    if (handle->spi_deinit == NULL)                                                        /* check spi_deinit */
+    else if (handle->spi_writev != NULL)                              /* if spi writev */
     {
-        handle->debug_print("sx1268: spi_deinit is null.\n");                              /* spi_deinit is null */
-       
-        return 3;                                                                          /* return error */
+        sx1268_spi_segment_t seg[2];
+        
+        memset(seg, 0, sizeof(sx1268_spi_segment_t) * 2);             /* clear the segments */
+        seg[0].tx_buf = &reg;                                         /* set the command */
+        seg[0].rx_buf = NULL;                                         /* no rx */
+        seg[0].len = 1;                                               /* 1 byte */
+        seg[1].tx_buf = buf;                                          /* set the payload */
+        seg[1].rx_buf = NULL;                                         /* no rx */
+        seg[1].len = len;                                             /* set the length */
+        res = handle->spi_writev(seg, (len != 0) ? 2 : 1);            /* spi writev */
     }
-    if (handle->spi_write_read == NULL)                                                    /* check spi_write_read */
+    else
+    {
+        memset(handle->buf, 0, sizeof(uint8_t) * 384);                /* clear the buffer */
+        handle->buf[0] = reg;                                         /* set the reg */
+        memcpy(&handle->buf[1], buf, len);                            /* copy the buffer */
+        res = handle->spi_write_read(handle->buf, len + 1, NULL, 0);  /* spi write */
+    }
+    if (res != 0)                                                     /* check result */
+    {
+        a_sx1268_config_save(handle, reg, buf, len, 0);               /* drop the shadow */
+        
+        return res;                                                   /* return error */
+    }
+    a_sx1268_config_save(handle, reg, buf, len, 1);                   /* save the shadow */
+    a_sx1268_config_capture(handle, reg, NULL, 0, buf, len);          /* capture the configuration */
+    a_sx1268_update_state(handle, reg, buf, len);                     /* update the chip state */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      read register bytes
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 spi read register failed
+ *             - 2 len is over 383
+ * @note       none
+ */
+static uint8_t a_sx1268_spi_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t reg_buf[3];
+    
+    if (len > (384 - 1))                                                            /* check the length */
+    {
+        handle->debug_print("sx1268: len is over 383.\n");                          /* len is over 383 */
+        
+        return 2;                                                                   /* return error */
+    }
+    
+    if (a_sx1268_cache_read(handle, reg, buf, len) == 0)                            /* read from the cache */
+    {
+        return 0;                                                                   /* success return 0 */
+    }
+    if (handle->batch_num != 0)                                                     /* check the batch */
+    {
+        if (a_sx1268_batch_flush(handle) != 0)                                      /* flush the batch */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    
+    reg_buf[0] = SX1268_COMMAND_READ_REGISTER;                                      /* set the command */
+    reg_buf[1] = (reg >> 8) & 0xFF;                                                 /* set msb */
+    reg_buf[2] = (reg >> 0) & 0xFF;                                                 /* set lsb */
+    if (handle->spi_writev != NULL)                                                 /* if spi writev */
+    {
+        sx1268_spi_segment_t seg[3];
+        uint8_t status;
+        
+        memset(seg, 0, sizeof(sx1268_spi_segment_t) * 3);                           /* clear the segments */
+        seg[0].tx_buf = (uint8_t *)reg_buf;                                         /* set the header */
+        seg[0].rx_buf = NULL;                                                       /* no rx */
+        seg[0].len = 3;                                                             /* 3 bytes */
+        seg[1].tx_buf = NULL;                                                       /* no tx */
+        seg[1].rx_buf = &status;                                                    /* set the status */
+        seg[1].len = 1;                                                             /* 1 byte */
+        seg[2].tx_buf = NULL;                                                       /* no tx */
+        seg[2].rx_buf = buf;                                                        /* read into the data buffer */
+        seg[2].len = len;                                                           /* set the length */
+        if (handle->spi_writev(seg, 3) != 0)                                        /* spi writev */
+        {
+            return 1;                                                               /* return error */
+        }
+        a_sx1268_save_status(handle, status);                                       /* save the status */
+        a_sx1268_cache_write(handle, reg, buf, len);                                /* update the cache */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+    
+    memset(handle->buf, 0, sizeof(uint8_t) * 384);                                  /* clear the buffer */
+    if (handle->spi_write_read((uint8_t *)reg_buf, 3, handle->buf, len + 1) != 0)   /* spi read */
+    {
+        return 1;                                                                   /* return error */
+    }
+    else
+    {
+        a_sx1268_save_status(handle, handle->buf[0]);                               /* save the status */
+        memcpy(buf, handle->buf + 1, len);                                          /* copy the data */
+        a_sx1268_cache_write(handle, reg, buf, len);                                /* update the cache */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+}
+
+/**
+ * @brief     write register bytes
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi write register failed
+ *            - 2 len is over 381
+ * @note      none
+ */
+static uint8_t a_sx1268_spi_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint8_t reg_buf[3];
+    
+    if (len > (384 - 3))                                              /* check the length */
+    {
+        handle->debug_print("sx1268: len is over 381.\n");            /* len is over 381 */
+        
+        return 2;                                                     /* return error */
+    }
+    if (a_sx1268_cache_unchanged(handle, reg, buf, len) != 0)         /* check the cached value */
+    {
+        return 0;                                                     /* skip the unchanged write */
+    }
+    
+    reg_buf[0] = SX1268_COMMAND_WRITE_REGISTER;                       /* set the commmand */
+    reg_buf[1] = (reg >> 8) & 0xFF;                                   /* set reg msb */
+    reg_buf[2] = (reg >> 0) & 0xFF;                                   /* set reg lsb */
+    if (handle->batch == 1)                                           /* if batch */
+    {
+        res = a_sx1268_batch_add(handle, (uint8_t *)reg_buf, 3, 
+                                 buf, len);                           /* add to the batch */
+        if (res != 0)                                                 /* check the result */
+        {
+            return res;                                               /* return error */
+        }
+    }
+    else if (handle->spi_writev != NULL)                              /* if spi writev */
+    {
+        sx1268_spi_segment_t seg[2];
+        
+        memset(seg, 0, sizeof(sx1268_spi_segment_t) * 2);             /* clear the segments */
+        seg[0].tx_buf = (uint8_t *)reg_buf;                           /* set the header */
+        seg[0].rx_buf = NULL;                                         /* no rx */
+        seg[0].len = 3;                                               /* 3 bytes */
+        seg[1].tx_buf = buf;                                          /* set the payload */
+        seg[1].rx_buf = NULL;                                         /* no rx */
+        seg[1].len = len;                                             /* set the length */
+        if (handle->spi_writev(seg, 2) != 0)                          /* spi writev */
+        {
+            return 1;                                                 /* return error */
+        }
+    }
+    else
+    {
+        memset(handle->buf, 0, sizeof(uint8_t) * 384);                /* clear the buffer */
+        memcpy(handle->buf, reg_buf, 3);                              /* copy the header */
+        memcpy(&handle->buf[3], buf, len);                            /* copy the buffer */
+        if (handle->spi_write_read(handle->buf, len + 3, NULL, 0) != 0) /* spi write */
+        {
+            return 1;                                                 /* return error */
+        }
+    }
+    a_sx1268_cache_write(handle, reg, buf, len);                      /* update the cache */
+    a_sx1268_config_capture(handle, SX1268_COMMAND_WRITE_REGISTER, 
+                            (uint8_t *)&reg_buf[1], 2, buf, len);     /* capture the configuration */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief         read or write a list of registers
+ * @param[in]     *handle points to a sx1268 handle structure
+ * @param[in]     *reg points to a register address list
+ * @param[in,out] *value points to a value buffer
+ * @param[in]     num is the register number
+ * @param[in]     write is the write flag
+ * @return        status code
+ *                - 0 success
+ *                - 1 access failed
+ *                - 4 chip is busy
+ * @note          num must not be over SX1268_REGISTERS_MAX_NUM
+ */
+static uint8_t a_sx1268_spi_access_registers(sx1268_handle_t *handle, uint16_t *reg, uint8_t *value, 
+                                             uint16_t num, uint8_t write)
+{
+    uint8_t order[SX1268_REGISTERS_MAX_NUM];
+    uint8_t run[SX1268_REGISTERS_MAX_NUM];
+    uint8_t tmp;
+    uint16_t i;
+    uint16_t j;
+    uint16_t start;
+    uint16_t len;
+    
+    for (i = 0; i < num; i++)                                                            /* init the order */
+    {
+        order[i] = (uint8_t)i;                                                           /* set the index */
+    }
+    for (i = 1; i < num; i++)                                                            /* stable insertion sort */
+    {
+        tmp = order[i];                                                                  /* save the index */
+        j = i;                                                                           /* set the position */
+        while ((j > 0) && (reg[order[j - 1]] > reg[tmp]))                                /* find the position */
+        {
+            order[j] = order[j - 1];                                                     /* move the index */
+            j--;                                                                         /* next */
+        }
+        order[j] = tmp;                                                                  /* insert the index */
+    }
+    
+    start = 0;                                                                           /* init 0 */
+    while (start < num)                                                                  /* run all bursts */
+    {
+        len = 1;                                                                         /* init 1 */
+        while (((start + len) < num) && 
+               (reg[order[start + len]] == (reg[order[start + len - 1]] + 1)))           /* merge adjacent addresses */
+        {
+            len++;                                                                       /* next */
+        }
+        if (a_sx1268_check_busy(handle) != 0)                                            /* check busy */
+        {
+            return 4;                                                                    /* return error */
+        }
+        if (write != 0)                                                                  /* write */
+        {
+            for (i = 0; i < len; i++)                                                    /* gather the values */
+            {
+                run[i] = value[order[start + i]];                                        /* set the value */
+            }
+            if (a_sx1268_spi_write_register(handle, reg[order[start]], 
+                                            (uint8_t *)run, len) != 0)                   /* write register */
+            {
+                return 1;                                                                /* return error */
+            }
+        }
+        else
+        {
+            if (a_sx1268_spi_read_register(handle, reg[order[start]], 
+                                           (uint8_t *)run, len) != 0)                    /* read register */
+            {
+                return 1;                                                                /* return error */
+            }
+            for (i = 0; i < len; i++)                                                    /* scatter the values */
+            {
+                value[order[start + i]] = run[i];                                        /* get the value */
+            }
+        }
+        start += len;                                                                    /* next burst */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     write buffer
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] offset is the buffer offset
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi write buffer failed
+ *            - 2 len is over 382
+ * @note      none
+ */
+static uint8_t a_sx1268_spi_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+{
+    if (len > (384 - 2))                                              /* check the length */
+    {
+        handle->debug_print("sx1268: len is over 382.\n");            /* len is over 382 */
+        
+        return 2;                                                     /* return error */
+    }
+    
+    if (handle->batch == 1)                                           /* if batch */
+    {
+        uint8_t reg_buf[2];
+        
+        reg_buf[0] = SX1268_COMMAND_WRITE_BUFFER;                     /* set the commmand */
+        reg_buf[1] = offset;                                          /* set the offset */
+        
+        return a_sx1268_batch_add(handle, (uint8_t *)reg_buf, 2, 
+                                  buf, len);                          /* add to the batch */
+    }
+    if (handle->spi_writev != NULL)                                   /* if spi writev */
+    {
+        sx1268_spi_segment_t seg[2];
+        uint8_t reg_buf[2];
+        
+        reg_buf[0] = SX1268_COMMAND_WRITE_BUFFER;                     /* set the commmand */
+        reg_buf[1] = offset;                                          /* set the offset */
+        memset(seg, 0, sizeof(sx1268_spi_segment_t) * 2);             /* clear the segments */
+        seg[0].tx_buf = (uint8_t *)reg_buf;                           /* set the header */
+        seg[0].rx_buf = NULL;                                         /* no rx */
+        seg[0].len = 2;                                               /* 2 bytes */
+        seg[1].tx_buf = buf;                                          /* send from the data buffer */
+        seg[1].rx_buf = NULL;                                         /* no rx */
+        seg[1].len = len;                                             /* set the length */
+        if (handle->spi_writev(seg, 2) != 0)                          /* spi writev */
+        {
+            return 1;                                                 /* return error */
+        }
+        
+        return 0;                                                     /* success return 0 */
+    }
+    
+    memset(handle->buf, 0, sizeof(uint8_t) * 384);                    /* clear the buffer */
+    handle->buf[0] = SX1268_COMMAND_WRITE_BUFFER;                     /* set the commmand */
+    handle->buf[1] = offset;                                          /* set reg msb */
+    memcpy(&handle->buf[2], buf, len);                                /* copy the buffer */
+    if (handle->spi_write_read(handle->buf, len + 2, NULL, 0) != 0)   /* spi write */
+    {
+        return 1;                                                     /* return error */
+    }
+    else
+    {
+        return 0;                                                     /* success return 0 */
+    }
+}
+
+/**
+ * @brief      read buffer
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  offset is the buffer offset
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 spi read buffer failed
+ *             - 2 len is over 383
+ * @note      none
+ */
+static uint8_t a_sx1268_spi_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+{
+    uint8_t reg_buf[2];
+    
+    if (len > (384 - 1))                                                            /* check the length */
+    {
+        handle->debug_print("sx1268: len is over 383.\n");                          /* len is over 383 */
+        
+        return 2;                                                                   /* return error */
+    }
+    
+    if (handle->batch_num != 0)                                                     /* check the batch */
+    {
+        if (a_sx1268_batch_flush(handle) != 0)                                      /* flush the batch */
+        {
+            return 1;                                                               /* return error */
+        }
+    }
+    
+    reg_buf[0] = SX1268_COMMAND_READ_BUFFER ;                                       /* set the command */
+    reg_buf[1] = offset;                                                            /* set msb */
+    if (handle->spi_writev != NULL)                                                 /* if spi writev */
+    {
+        sx1268_spi_segment_t seg[3];
+        uint8_t status;
+        
+        memset(seg, 0, sizeof(sx1268_spi_segment_t) * 3);                           /* clear the segments */
+        seg[0].tx_buf = (uint8_t *)reg_buf;                                         /* set the header */
+        seg[0].rx_buf = NULL;                                                       /* no rx */
+        seg[0].len = 2;                                                             /* 2 bytes */
+        seg[1].tx_buf = NULL;                                                       /* no tx */
+        seg[1].rx_buf = &status;                                                    /* set the status */
+        seg[1].len = 1;                                                             /* 1 byte */
+        seg[2].tx_buf = NULL;                                                       /* no tx */
+        seg[2].rx_buf = buf;                                                        /* read into the data buffer */
+        seg[2].len = len;                                                           /* set the length */
+        if (handle->spi_writev(seg, 3) != 0)                                        /* spi writev */
+        {
+            return 1;                                                               /* return error */
+        }
+        a_sx1268_save_status(handle, status);                                       /* save the status */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+    
+    memset(handle->buf, 0, sizeof(uint8_t) * 384);                                  /* clear the buffer */
+    if (handle->spi_write_read((uint8_t *)reg_buf, 2, handle->buf, len + 1) != 0)   /* spi write */
+    {
+        return 1;                                                                   /* return error */
+    }
+    else
+    {
+        a_sx1268_save_status(handle, handle->buf[0]);                               /* save the status */
+        memcpy(buf, handle->buf + 1, len);                                          /* copy the data */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+}
+
+/**
+ * @brief     retune to the next hop channel
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 hop failed
+ *            - 4 chip is busy
+ *            - 5 no channel is available
+ * @note      none
+ */
+static uint8_t a_sx1268_hop_next(sx1268_handle_t *handle)
+{
+    uint8_t i;
+    uint8_t next;
+    sx1268_hop_channel_t *ch;
+    
+    if (handle->hop_mode == SX1268_HOP_MODE_RANDOM)                                      /* random */
+    {
+        handle->hop_seed ^= handle->hop_seed << 13;                                      /* xorshift */
+        handle->hop_seed ^= handle->hop_seed >> 17;                                      /* xorshift */
+        handle->hop_seed ^= handle->hop_seed << 5;                                       /* xorshift */
+        next = (uint8_t)(handle->hop_seed % handle->hop_num);                            /* get the channel */
+    }
+    else
+    {
+        next = (uint8_t)((handle->hop_channel + 1) % handle->hop_num);                   /* next channel */
+    }
+    for (i = 0; i < handle->hop_num; i++)                                                /* skip the blacklist */
+    {
+        if (handle->hop_table[next].blacklist == 0)                                      /* check the blacklist */
+        {
+            break;                                                                       /* break */
+        }
+        next = (uint8_t)((next + 1) % handle->hop_num);                                  /* next channel */
+    }
+    if (i == handle->hop_num)                                                            /* check the channel */
+    {
+        return 5;                                                                        /* return error */
+    }
+    
+    ch = &handle->hop_table[next];                                                       /* get the channel */
+    if ((ch->image[0] != handle->hop_image[0]) || (ch->image[1] != handle->hop_image[1]))  /* check the image band */
+    {
+        if (a_sx1268_check_busy(handle) != 0)                                            /* check busy */
+        {
+            return 4;                                                                    /* return error */
+        }
+        if (a_sx1268_spi_write(handle, SX1268_COMMAND_SET_CALIBRATE_IMAGE, 
+                               ch->image, 2) != 0)                                       /* write command */
+        {
+            return 1;                                                                    /* return error */
+        }
+        handle->hop_image[0] = ch->image[0];                                             /* save the image band */
+        handle->hop_image[1] = ch->image[1];                                             /* save the image band */
+    }
+    if (a_sx1268_check_busy(handle) != 0)                                                /* check busy */
+    {
+        return 4;                                                                        /* return error */
+    }
+    if (a_sx1268_spi_write(handle, SX1268_COMMAND_SET_RF_FREQUENCY, 
+                           ch->frequency, 4) != 0)                                       /* write command */
+    {
+        return 1;                                                                        /* return error */
+    }
+    handle->hop_channel = next;                                                          /* save the channel */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     lora transmit start helper
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 sent failed
+ *            - 4 chip is busy
+ *            - 5 len is over the tx buffer
+ * @note      len must not be over 256 - tx base address, the buffer does not wrap
+ */
+static uint8_t a_sx1268_lora_transmit_start(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                                            uint16_t preamble_length, sx1268_lora_header_t header_type,
+                                            sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
+                                            uint8_t *buf, uint16_t len, uint32_t us)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t buffer[6];
+    uint16_t clear_irq_param;
+    uint32_t reg;
+    
+    if (len > 256 - (uint16_t)handle->tx_base)                                                             /* check the tx buffer */
+    {
+        handle->debug_print("sx1268: len is over the tx buffer.\n");                                      /* len is over the tx buffer */
+       
+        return 5;                                                                                          /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    
+    clear_irq_param = 0x03FF;                                                                              /* set mask */
+    buffer[0] = (clear_irq_param >> 8) & 0xFF;                                                             /* set param */
+    buffer[1] = (clear_irq_param >> 0) & 0xFF;                                                             /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buffer, 2);               /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                                         /* clear irq status failed */
+       
+        return 1;                                                                                          /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    
+    prev = standby_src;                                                                                    /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_STANDBY, (uint8_t *)&prev, 1);                     /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: set standby failed.\n");                                              /* set standby failed */
+       
+        return 1;                                                                                          /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    
+    buffer[0] = (preamble_length >> 8) & 0xFF;                                                             /* set param */
+    buffer[1] = (preamble_length >> 0) & 0xFF;                                                             /* set param */
+    buffer[2] = header_type;                                                                               /* set param */
+    buffer[3] = (uint8_t)len;                                                                              /* set param */
+    buffer[4] = crc_type;                                                                                  /* set param */
+    buffer[5] = invert_iq_enable;                                                                          /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_PACKET_PARAMS, (uint8_t *)buffer, 6);              /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: set lora modulation params failed.\n");                               /* set lora modulation params failed */
+       
+        return 1;                                                                                          /* return error */
+    }
+    
+    if (invert_iq_enable == SX1268_BOOL_FALSE)                                                             /* not invert iq */
+    {
+        uint8_t setup;
+        
+        res = a_sx1268_check_busy(handle);                                                                 /* check busy */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                                                /* chip is busy */
+           
+            return 4;                                                                                      /* return error */
+        }
+        
+        res = a_sx1268_spi_read_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);      /* read register */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
+           
+            return 1;                                                                                      /* return error */
+        }
+        
+        setup |= (1 << 2);                                                                                 /* set bit 2 */
+        res = a_sx1268_spi_write_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);     /* read register */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
+           
+            return 1;                                                                                      /* return error */
+        }
+    }
+    else
+    {
+        uint8_t setup;
+        
+        res = a_sx1268_check_busy(handle);                                                                 /* check busy */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                                                /* chip is busy */
+           
+            return 4;                                                                                      /* return error */
+        }
+        
+        res = a_sx1268_spi_read_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);      /* read register */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
+           
+            return 1;                                                                                      /* return error */
+        }
+        
+        setup &= ~(1 << 2);                                                                                /* clear bit 2 */
+        res = a_sx1268_spi_write_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);     /* read register */
+        if (res != 0)                                                                                      /* check result */
+        {
+            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
+           
+            return 1;                                                                                      /* return error */
+        }
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    
+    if (a_sx1268_spi_write_buffer(handle, handle->tx_base, buf, len) != 0)                                 /* write at the tx base */
+    {
+        handle->debug_print("sx1268: write buffer failed.\n");                                             /* write buffer failed */
+       
+        return 1;                                                                                          /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    
+    reg = (uint32_t)(((uint64_t)us * 8) / 125);                                                           /* convert the timeout */
+    buffer[0] = (reg >> 16) & 0xFF;                                                                        /* bit 23 : 16 */
+    buffer[1] = (reg >> 8) & 0xFF;                                                                         /* bit 15 : 8 */
+    buffer[2] = (reg >> 0) & 0xFF;                                                                         /* bit 7 : 0 */
+    handle->tx_done = 0;                                                                                   /* flag 0 */
+    handle->timeout = 0;                                                                                   /* flag 0 */
+    handle->operation = SX1268_OPERATION_TX;                                                               /* set operation */
+    handle->operation_status = SX1268_OPERATION_STATUS_RUNNING;                                            /* wait for the irq */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_TX, (uint8_t *)buffer, 3);                         /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: set tx failed.\n");                                                   /* set tx failed */
+        handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                                           /* not started */
+       
+        return 1;                                                                                          /* return error */
+    }
+    
+    return 0;                                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      pop the next frame from the priority tx queue
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] **buf points to a frame buffer pointer
+ * @param[out] *len points to a frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 queue is empty
+ * @note       only one consumer is allowed
+ */
+static uint8_t a_sx1268_tx_queue_pop(sx1268_handle_t *handle, uint8_t **buf, uint16_t *len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SX1268_TX_QUEUE_PRIORITY_NUM; i++)                                  /* from the highest priority */
+    {
+        sx1268_tx_queue_t *q = &handle->tx_queue[i];
+        uint32_t pos = q->head;
+        sx1268_tx_slot_t *slot = &q->slot[pos & (SX1268_TX_QUEUE_DEPTH - 1)];
+        
+        if ((int32_t)(slot->seq - (pos + 1)) < 0)                                       /* not published */
+        {
+            continue;                                                                   /* next priority */
+        }
+        SX1268_TX_QUEUE_BARRIER();                                                      /* read the slot after seq */
+        *buf = slot->buf;                                                               /* get buffer */
+        *len = slot->len;                                                               /* get length */
+        SX1268_TX_QUEUE_BARRIER();                                                      /* release the slot after reading */
+        slot->seq = pos + SX1268_TX_QUEUE_DEPTH;                                        /* free the slot */
+        q->head = pos + 1;                                                              /* next position */
+        
+        return 0;                                                                       /* success return 0 */
+    }
+    
+    return 1;                                                                           /* return empty */
+}
+
+/**
+ * @brief     read the received packet into the rx ring
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] offset is the rx buffer offset
+ * @param[in] len is the packet length
+ * @return    status code
+ *            - 0 success
+ *            - 1 read buffer failed
+ * @note      packets with crc error are skipped, a full ring or a short slot increases the overflow counter
+ */
+static uint8_t a_sx1268_rx_ring_push(sx1268_handle_t *handle, uint8_t offset, uint8_t len)
+{
+    uint8_t *slot;
+    uint32_t tail;
+    
+    if (handle->crc_error != 0)                                                          /* check crc error */
+    {
+        return 0;                                                                        /* skip */
+    }
+    tail = handle->rx_ring_tail;                                                         /* get tail */
+    if (((tail - handle->rx_ring_head) >= handle->rx_ring_depth) ||
+        ((uint16_t)(len + SX1268_RX_RING_HEADER_SIZE) > handle->rx_ring_slot_size))      /* check space */
+    {
+        handle->rx_ring_overflow++;                                                      /* drop the packet */
+        
+        return 0;                                                                        /* success return 0 */
+    }
+    SX1268_RX_RING_BARRIER();                                                            /* slot is free after head */
+    slot = &handle->rx_ring_buf[(tail % handle->rx_ring_depth) * 
+                                handle->rx_ring_slot_size];                              /* get slot */
+    if (a_sx1268_spi_read_buffer(handle, offset, 
+                                 &slot[SX1268_RX_RING_HEADER_SIZE], len) != 0)           /* read buffer */
+    {
+        return 1;                                                                        /* return error */
+    }
+    slot[0] = len;                                                                       /* length low */
+    slot[1] = 0;                                                                         /* length high */
+    SX1268_RX_RING_BARRIER();                                                            /* write the slot before tail */
+    handle->rx_ring_tail = tail + 1;                                                     /* publish */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      peek the packet header and run the rx filter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  offset is the rx buffer offset
+ * @param[in]  len is the packet length
+ * @param[out] *header points to a header buffer
+ * @param[out] *accept points to an accept flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read buffer failed
+ * @note       a packet shorter than the header is rejected without reading
+ */
+static uint8_t a_sx1268_rx_filter(sx1268_handle_t *handle, uint8_t offset, uint8_t len, uint8_t *header, uint8_t *accept)
+{
+    uint8_t address;
+    
+    *accept = 0;                                                                            /* reject */
+    if (len < handle->rx_filter_header_len)                                                 /* too short */
+    {
+        return 0;                                                                           /* success return 0 */
+    }
+    if (a_sx1268_spi_read_buffer(handle, offset, header, handle->rx_filter_header_len) != 0)/* read the header */
+    {
+        return 1;                                                                           /* return error */
+    }
+    if (handle->rx_filter_match != NULL)                                                    /* user match */
+    {
+        *accept = (handle->rx_filter_match(header, handle->rx_filter_header_len) != 0) ? 1 : 0;   /* run match */
+    }
+    else
+    {
+        address = header[handle->rx_filter_address_offset];                                 /* get address */
+        *accept = ((handle->rx_filter_map[address >> 3] & (1 << (address & 7))) != 0) ? 1 : 0;   /* look up the set */
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      clear the irq status and get the rx buffer and packet status in one bus transfer
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  *clear points to a clear irq param buffer
+ * @param[out] *rx_status points to a rx buffer status buffer
+ * @param[out] *packet_status points to a packet status buffer, NULL skips it
+ * @return     status code
+ *             - 0 success
+ *             - 1 spi writev failed
+ * @note       rx_status and packet_status have the same layout as a_sx1268_spi_read,
+ *             busy is polled before the first segment only, the later segments rely on the
+ *             spi_writev link waiting SX1268_IRQ_FAST_PATH_GAP_US with the chip select high
+ */
+static uint8_t a_sx1268_irq_clear_rx_status(sx1268_handle_t *handle, uint8_t *clear, uint8_t *rx_status,
+                                            uint8_t *packet_status)
+{
+    sx1268_spi_segment_t seg[3];
+    uint8_t cmd[3];
+    uint8_t tx[4];
+    uint8_t rx[4];
+    uint8_t pkt_tx[5];
+    uint8_t pkt_rx[5];
+    
+    cmd[0] = SX1268_COMMAND_CLEAR_IRQ_STATUS;                                   /* set the command */
+    cmd[1] = clear[0];                                                          /* set param */
+    cmd[2] = clear[1];                                                          /* set param */
+    memset(tx, 0, sizeof(uint8_t) * 4);                                         /* clear the buffer */
+    tx[0] = SX1268_COMMAND_GET_RX_BUFFER_STATUS;                                /* set the command */
+    memset(pkt_tx, 0, sizeof(uint8_t) * 5);                                     /* clear the buffer */
+    pkt_tx[0] = SX1268_COMMAND_GET_PACKET_STATUS;                               /* set the command */
+    memset(seg, 0, sizeof(sx1268_spi_segment_t) * 3);                           /* clear the segments */
+    seg[0].tx_buf = cmd;                                                        /* clear irq status */
+    seg[0].rx_buf = NULL;                                                       /* no rx */
+    seg[0].len = 3;                                                             /* 3 bytes */
+    seg[0].cs_change = 1;                                                       /* end of the command */
+    seg[0].delay_us = SX1268_IRQ_FAST_PATH_GAP_US;                              /* wait for the busy */
+    seg[1].tx_buf = tx;                                                         /* get rx buffer status */
+    seg[1].rx_buf = rx;                                                         /* read the status */
+    seg[1].len = 4;                                                             /* 4 bytes */
+    seg[1].cs_change = 1;                                                       /* end of the command */
+    seg[1].delay_us = SX1268_IRQ_FAST_PATH_GAP_US;                              /* wait for the busy */
+    seg[2].tx_buf = pkt_tx;                                                     /* get packet status */
+    seg[2].rx_buf = pkt_rx;                                                     /* read the status */
+    seg[2].len = 5;                                                             /* 5 bytes */
+    if (a_sx1268_check_busy(handle) != 0)                                       /* check busy before the first segment */
+    {
+        return 1;                                                               /* return error */
+    }
+    if (handle->spi_writev(seg, (packet_status != NULL) ? 3 : 2) != 0)          /* spi writev */
+    {
+        return 1;                                                               /* return error */
+    }
+    a_sx1268_save_status(handle, rx[1]);                                        /* save the status */
+    rx_status[0] = rx[1];                                                       /* status */
+    rx_status[1] = rx[2];                                                       /* payload length */
+    rx_status[2] = rx[3];                                                       /* start pointer */
+    if (packet_status != NULL)                                                  /* check the packet status */
+    {
+        memcpy(packet_status, &pkt_rx[1], 4);                                   /* status and packet status */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     check if one irq type has a callback
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] type is the irq type
+ * @return    1 if a callback runs for the type, otherwise 0
+ * @note      none
+ */
+static uint8_t a_sx1268_irq_has_callback(sx1268_handle_t *handle, uint16_t type)
+{
+    if (handle->irq_table == 0)                                          /* no handler table */
+    {
+        return (handle->receive_callback != NULL) ? 1 : 0;               /* receive callback */
+    }
+    
+    return ((handle->irq_handler_mask & type) != 0) ? 1 : 0;             /* registered handler */
+}
+
+/**
+ * @brief     run the callback of one irq type
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] type is the irq type
+ * @param[in] *buf points to a buffer address
+ * @param[in] len is the buffer length
+ * @note      none
+ */
+static void a_sx1268_irq_notify(sx1268_handle_t *handle, uint16_t type, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    
+    if (handle->irq_table == 0)                                          /* no handler table */
+    {
+        if (handle->receive_callback != NULL)                            /* if receive callback */
+        {
+            handle->receive_callback(type, buf, len);                    /* run callback */
+        }
+        
+        return;                                                          /* return */
+    }
+    if ((handle->irq_handler_mask & type) == 0)                          /* not registered */
+    {
+        return;                                                          /* skip */
+    }
+    i = 0;                                                               /* from bit 0 */
+    while ((type >> i) != 1)                                             /* find the bit */
+    {
+        i++;                                                             /* next bit */
+    }
+    handle->irq_handler[i](buf, len);                                    /* run handler */
+}
+
+/**
+ * @brief     check if the tx queue has a published frame
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    1 if a frame is waiting, otherwise 0
+ * @note      it only reads the queue and can run beside the consumer
+ */
+static uint8_t a_sx1268_tx_queue_pending(sx1268_handle_t *handle)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SX1268_TX_QUEUE_PRIORITY_NUM; i++)                                  /* all priorities */
+    {
+        sx1268_tx_queue_t *q = &handle->tx_queue[i];
+        uint32_t pos = q->head;
+        
+        if ((int32_t)(q->slot[pos & (SX1268_TX_QUEUE_DEPTH - 1)].seq - (pos + 1)) >= 0) /* published */
+        {
+            return 1;                                                                   /* waiting */
+        }
+    }
+    
+    return 0;                                                                           /* empty */
+}
+
+/**
+ * @brief     send the next queued frame
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ *            - 4 chip is busy
+ *            - 5 len is over the tx buffer
+ * @note      the caller must own tx_queue_active, the flag is released when the queue is empty
+ *            or the start fails, a frame which fails to start stays at the head of the queue
+ *            and is sent first by the next sx1268_tx_queue_start
+ */
+static uint8_t a_sx1268_tx_queue_dispatch(sx1268_handle_t *handle)
+{
+    uint8_t res;
+    
+    while (handle->tx_queue_retry == 0)                                                 /* no frame to resend */
+    {
+        if (a_sx1268_tx_queue_pop(handle, &handle->tx_queue_buf, &handle->tx_queue_len) == 0) /* pop a frame */
+        {
+            break;                                                                      /* send it */
+        }
+        handle->tx_queue_active = 0;                                                    /* nothing on air */
+        SX1268_TX_QUEUE_BARRIER();                                                      /* release before the re-check */
+        if ((a_sx1268_tx_queue_pending(handle) == 0) || 
+            (SX1268_TX_QUEUE_CAS(&handle->tx_queue_active, 0, 1) == 0))                 /* a push raced with the release */
+        {
+            return 0;                                                                   /* success return 0 */
+        }
+    }
+    res = a_sx1268_lora_transmit_start(handle, (sx1268_clock_source_t)handle->tx_queue_standby,
+                                       handle->tx_queue_preamble,
+                                       (sx1268_lora_header_t)handle->tx_queue_header,
+                                       (sx1268_lora_crc_type_t)handle->tx_queue_crc,
+                                       (sx1268_bool_t)handle->tx_queue_iq,
+                                       handle->tx_queue_buf, handle->tx_queue_len, 
+                                       handle->tx_queue_timeout_us);                    /* start transmit */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->tx_queue_retry = 1;                                                     /* keep the frame at the head */
+        SX1268_TX_QUEUE_BARRIER();                                                      /* save the frame before the release */
+        handle->tx_queue_active = 0;                                                    /* nothing on air */
+        
+        return res;                                                                     /* return error */
+    }
+    handle->tx_queue_retry = 0;                                                         /* frame is on air */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     process the irq
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] timestamp is the irq time in us
+ * @param[in] status_mask is the handled irq mask or the known irq status
+ * @param[in] status_known is the known irq status flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_sx1268_irq_process_status(sx1268_handle_t *handle, uint32_t timestamp, uint16_t status_mask, uint8_t status_known)
+{
+    uint8_t res;
+    uint8_t buf[3]; 
+    uint16_t status;
+    uint16_t clear;
+    uint8_t rx_status[3];
+    uint8_t packet_status[4];
+    uint8_t rx_status_valid;
+    uint8_t hop;
+    
+    memset(buf, 0, sizeof(uint8_t) * 3);                                                                       /* clear the buffer */
+    if (status_known != 0)                                                                                     /* cause is known from the line */
+    {
+        status = status_mask;                                                                                  /* set status */
+    }
+    else
+    {
+        res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_IRQ_STATUS, (uint8_t *)buf, 3);                     /* read command */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: get irq status failed.\n");                                           /* get irq status failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+        status = (((uint16_t)buf[1] << 8) | buf[2]) & status_mask;                                             /* set status */
+    }
+    if (status_known != 0)                                                                                     /* cause is known from the line */
+    {
+        clear = 0x03FF & (uint16_t)(~((handle->irq_line_mask[0] | handle->irq_line_mask[1] | 
+                                       handle->irq_line_mask[2]) & handle->irq_mask & (uint16_t)(~status)));   /* clear all bits except the other lines */
+    }
+    else
+    {
+        clear = status;                                                                                        /* only clear the handled bits */
+    }
+    buf[1] = (clear >> 8) & 0xFF;                                                                              /* set param */
+    buf[2] = (clear >> 0) & 0xFF;                                                                              /* set param */
+    handle->irq_stat_irq++;                                                                                    /* count the interrupt */
+    handle->irq_stat_since++;                                                                                  /* count for this packet */
+    if ((status & (SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE)) != 0)                                             /* packet done */
+    {
+        handle->irq_stat_packet++;                                                                             /* count the packet */
+        handle->irq_stat_last = handle->irq_stat_since;                                                        /* save interrupts per packet */
+        handle->irq_stat_since = 0;                                                                            /* restart */
+    }
+    rx_status_valid = 0;                                                                                       /* no rx buffer status */
+    memset(packet_status, 0, sizeof(uint8_t) * 4);                                                             /* clear the packet status */
+    if ((handle->irq_fast != 0) && (handle->spi_writev != NULL) && (handle->batch == 0) && 
+        ((status & SX1268_IRQ_RX_DONE) != 0))                                                                  /* fast path rx done */
+    {
+        res = a_sx1268_irq_clear_rx_status(handle, (uint8_t *)&buf[1], (uint8_t *)rx_status, 
+                                           (handle->rx_packet_callback != NULL) ? 
+                                           (uint8_t *)packet_status : NULL);                                   /* clear and get rx buffer and packet status */
+        rx_status_valid = 1;                                                                                   /* rx buffer and packet status are read */
+    }
+    else
+    {
+        res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)&buf[1], 2);              /* write command */
+    }
+    if (res != 0)                                                                                              /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                                             /* clear irq status failed */
+       
+        return 1;                                                                                              /* return error */
+    }
+    if (((status & SX1268_IRQ_RX_DONE) != 0) && (rx_status_valid == 0))                                        /* rx done on the normal path */
+    {
+        memset(rx_status, 0, sizeof(uint8_t) * 3);                                                             /* clear the buffer */
+        res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_RX_BUFFER_STATUS, (uint8_t *)rx_status, 3);         /* read command */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: get rx buffer status failed.\n");                                     /* get rx buffer status failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+        if (handle->rx_packet_callback != NULL)                                                                /* if rx packet callback */
+        {
+            res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_PACKET_STATUS, (uint8_t *)packet_status, 4);    /* read command */
+            if (res != 0)                                                                                      /* check result */
+            {
+                handle->debug_print("sx1268: get packet status failed.\n");                                    /* get packet status failed */
+               
+                return 1;                                                                                      /* return error */
+            }
+        }
+    }
+    
+    handle->crc_error = 0;                                                                                     /* clear crc error */
+    if ((status & SX1268_IRQ_PREAMBLE_DETECTED) != 0)                                                          /* if preamble detected */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_PREAMBLE_DETECTED, NULL, 0);                                    /* run callback */
+    }
+    if ((status & SX1268_IRQ_SYNC_WORD_VALID) != 0)                                                            /* if valid sync word detected */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_SYNC_WORD_VALID, NULL, 0);                                      /* run callback */
+    }
+    if ((status & SX1268_IRQ_HEADER_VALID) != 0)                                                               /* if valid header */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_HEADER_VALID, NULL, 0);                                         /* run callback */
+    }
+    if ((status & SX1268_IRQ_HEADER_ERR) != 0)                                                                 /* if header error */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_HEADER_ERR, NULL, 0);                                           /* run callback */
+    }
+    if ((status & SX1268_IRQ_CRC_ERR) != 0)                                                                    /* if crc error */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_CRC_ERR, NULL, 0);                                              /* run callback */
+        handle->crc_error = 1;                                                                                 /* set crc error */
+    }
+    if ((status & SX1268_IRQ_CAD_DONE) != 0)                                                                   /* if cad done */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_CAD_DONE, NULL, 0);                                             /* run callback */
+        if ((handle->cad_exit_rx == 1) && ((status & SX1268_IRQ_CAD_DETECTED) != 0))                           /* check cad exit mode */
+        {
+            handle->state = SX1268_CHIP_STATE_RX;                                                              /* stay in rx */
+        }
+        else
+        {
+            handle->state = SX1268_CHIP_STATE_STANDBY_RC;                                                      /* back to standby rc */
+        }
+        if (handle->operation == SX1268_OPERATION_CAD)                                                         /* check operation */
+        {
+            handle->operation_status = ((status & SX1268_IRQ_CAD_DETECTED) != 0) ? 
+                                       SX1268_OPERATION_STATUS_CAD_DETECTED : SX1268_OPERATION_STATUS_DONE;    /* cad result */
+        }
+        handle->cad_done = 1;                                                                                  /* set cad done */
+    }
+    if ((status & SX1268_IRQ_CAD_DETECTED) != 0)                                                               /* if cad detected */
+    {
+        a_sx1268_irq_notify(handle, SX1268_IRQ_CAD_DETECTED, NULL, 0);                                         /* run callback */
+        handle->cad_detected = 1;                                                                              /* set detected */
+    }
+    if ((status & SX1268_IRQ_TIMEOUT) != 0)                                                                    /* if timeout */
+    {
+        uint8_t control;
+        uint8_t mask;
+        
+        control = 0x00;
+        res = a_sx1268_spi_write_register(handle, SX1268_REG_DIO3_OUTPUT_CONTROL, (uint8_t *)&control, 1);     /* write register */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: write register failed.\n");                                           /* write register failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+        
+        /* read mask */
+        res = a_sx1268_spi_read_register(handle, SX1268_REG_EVENT_MASK, (uint8_t *)&mask, 1);                  /* read register */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: read register failed.\n");                                            /* read register failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+        mask |= 0x02;                                                                                          /* set mask */
+        res = a_sx1268_spi_write_register(handle, SX1268_REG_EVENT_MASK, (uint8_t *)&mask, 1);                 /* write register */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: write register failed.\n");                                           /* write register failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+        
+        if (handle->tx_queue_active != 0)                                                                      /* queued frame */
+        {
+            a_sx1268_irq_notify(handle, SX1268_IRQ_TIMEOUT, handle->tx_queue_buf, handle->tx_queue_len);       /* give the buffer back */
+        }
+        else
+        {
+            a_sx1268_irq_notify(handle, SX1268_IRQ_TIMEOUT, NULL, 0);                                          /* run callback */
+        }
+        handle->state = handle->fallback_state;                                                                /* fall back */
+        if ((handle->operation == SX1268_OPERATION_TX) || (handle->operation == SX1268_OPERATION_RX))          /* check operation */
+        {
+            handle->operation_status = SX1268_OPERATION_STATUS_TIMEOUT;                                        /* timeout */
+        }
+        handle->timeout = 1;                                                                                   /* flag timeout */
+    }
+    if ((status & SX1268_IRQ_TX_DONE) != 0)                                                                    /* if tx done */
+    {
+        if (handle->tx_queue_active != 0)                                                                      /* queued frame */
+        {
+            a_sx1268_irq_notify(handle, SX1268_IRQ_TX_DONE, handle->tx_queue_buf, handle->tx_queue_len);       /* give the buffer back */
+        }
+        else
+        {
+            a_sx1268_irq_notify(handle, SX1268_IRQ_TX_DONE, NULL, 0);                                          /* run callback */
+        }
+        handle->state = handle->fallback_state;                                                                /* fall back */
+        if (handle->operation == SX1268_OPERATION_TX)                                                          /* check operation */
+        {
+            handle->operation_status = SX1268_OPERATION_STATUS_DONE;                                           /* tx done */
+        }
+        handle->tx_done = 1;                                                                                   /* flag tx done */
+    }
+    if ((status & SX1268_IRQ_RX_DONE) != 0)                                                                    /* if rx done */
+    {
+        uint8_t payload_length_rx;
+        uint8_t rx_start_buffer_pointer;
+        uint8_t header[SX1268_RX_FILTER_HEADER_MAX];
+        uint8_t accept;
+        uint8_t peeked;
+        uint8_t *payload;
+        
+        payload_length_rx = rx_status[1];                                                                      /* set status */
+        rx_start_buffer_pointer = rx_status[2];                                                                /* set status */
+        if (handle->rx_continuous == 0)                                                                        /* check single rx */
+        {
+            handle->state = handle->fallback_state;                                                            /* fall back */
+        }
+        
+        accept = 1;                                                                                            /* accept by default */
+        peeked = 0;                                                                                            /* no header read */
+        if ((handle->rx_filter_enable != 0) && (handle->crc_error == 0))                                       /* rx filter */
+        {
+            res = a_sx1268_rx_filter(handle, rx_start_buffer_pointer, payload_length_rx,
+                                     (uint8_t *)header, (uint8_t *)&accept);                                   /* peek the header */
+            if (res != 0)                                                                                      /* check result */
+            {
+                handle->debug_print("sx1268: read buffer failed.\n");                                          /* read buffer failed */
+               
+                return 1;                                                                                      /* return error */
+            }
+            if (accept == 0)                                                                                   /* not for us */
+            {
+                handle->rx_filter_dropped++;                                                                   /* count the packet */
+            }
+            else
+            {
+                peeked = handle->rx_filter_header_len;                                                         /* header is read */
+            }
+        }
+        payload = NULL;                                                                                        /* no payload buffer */
+        if ((accept != 0) && (handle->crc_error == 0) && (handle->rx_ring_buf == NULL))                        /* payload is wanted */
+        {
+            if (handle->rx_buffer_provider != NULL)                                                            /* application buffer */
+            {
+                payload = handle->rx_buffer_provider(payload_length_rx);                                       /* get the buffer */
+                if (payload == NULL)                                                                           /* no buffer */
+                {
+                    handle->rx_buffer_dropped++;                                                               /* count the packet */
+                    accept = 0;                                                                                /* drop the packet */
+                }
+            }
+            else
+            {
+#if (SX1268_RECEIVE_BUFFER_ENABLE == 1)
+                payload = handle->receive_buf;                                                                 /* inner buffer */
+#endif
+            }
+        }
+        res = 0;                                                                                               /* nothing to read */
+        if ((accept != 0) && (handle->rx_ring_buf != NULL))                                                    /* rx ring */
+        {
+            res = a_sx1268_rx_ring_push(handle, rx_start_buffer_pointer, payload_length_rx);                   /* read into the ring */
+        }
+        else if (payload != NULL)                                                                              /* read the payload */
+        {
+            memcpy(payload, header, peeked);                                                                   /* copy the peeked header */
+            if (payload_length_rx > peeked)                                                                    /* payload left */
+            {
+                res = a_sx1268_spi_read_buffer(handle, (uint8_t)(rx_start_buffer_pointer + peeked), 
+                                               payload + peeked, payload_length_rx - peeked);                  /* read buffer */
+            }
+        }
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: read buffer failed.\n");                                              /* read buffer failed */
+            if ((payload != NULL) && (handle->rx_buffer_provider != NULL))                                     /* application buffer */
+            {
+                handle->rx_buffer_release(payload);                                                            /* give the buffer back */
+            }
+           
+            return 1;                                                                                          /* return error */
+        }
+        if (handle->operation == SX1268_OPERATION_RX)                                                          /* check operation */
+        {
+            handle->operation_status = (handle->crc_error == 0) ? 
+                                       SX1268_OPERATION_STATUS_DONE : SX1268_OPERATION_STATUS_CRC_ERROR;       /* rx result */
+        }
+        if (accept != 0)                                                                                       /* for us */
+        {
+            if (handle->rx_packet_callback != NULL)                                                            /* if rx packet callback */
+            {
+                sx1268_rx_packet_t packet;
+                
+                memset(&packet, 0, sizeof(sx1268_rx_packet_t));                                                /* clear the packet */
+                packet.crc_error = handle->crc_error;                                                          /* set crc error */
+                packet.payload = payload;                                                                      /* set payload */
+                packet.len = payload_length_rx;                                                                /* set length */
+                packet.packet_type = handle->packet_type;                                                      /* set packet type */
+                if (handle->packet_type == SX1268_PACKET_TYPE_LORA)                                            /* lora packet status */
+                {
+                    packet.rssi_pkt_raw = packet_status[1];                                                    /* set raw rssi */
+                    packet.snr_pkt_raw = packet_status[2];                                                     /* set raw snr */
+                    packet.signal_rssi_pkt_raw = packet_status[3];                                             /* set raw signal rssi */
+                    packet.rssi_pkt = -(int16_t)packet_status[1] * 50;                                         /* convert rssi */
+                    packet.snr_pkt = (int16_t)((int8_t)packet_status[2]) * 25;                                 /* snr is signed */
+                    packet.signal_rssi_pkt = -(int16_t)packet_status[3] * 50;                                  /* convert signal rssi */
+                }
+                else
+                {
+                    packet.rx_status_raw = packet_status[1];                                                   /* set raw rx status */
+                    packet.rssi_sync_raw = packet_status[2];                                                   /* set raw rssi sync */
+                    packet.rssi_avg_raw = packet_status[3];                                                    /* set raw rssi avg */
+                    packet.rssi_sync = -(int16_t)packet_status[2] * 50;                                        /* convert rssi sync */
+                    packet.rssi_avg = -(int16_t)packet_status[3] * 50;                                         /* convert rssi avg */
+                }
+                packet.timestamp_us = timestamp;                                                               /* set timestamp */
+                handle->rx_packet_callback(&packet);                                                           /* run callback */
+            }
+            if ((payload != NULL) && (handle->rx_buffer_provider != NULL) && 
+                (a_sx1268_irq_has_callback(handle, SX1268_IRQ_RX_DONE) == 0))                                  /* nobody takes the buffer */
+            {
+                handle->rx_buffer_release(payload);                                                            /* give the buffer back */
+            }
+            else if (payload != NULL)                                                                          /* check payload */
+            {
+                a_sx1268_irq_notify(handle, SX1268_IRQ_RX_DONE, payload, payload_length_rx);                   /* hand the buffer off last */
+            }
+            else
+            {
+                a_sx1268_irq_notify(handle, SX1268_IRQ_RX_DONE, NULL, 0);                                      /* run callback */
+            }
+        }
+    }
+    if (handle->irq_status_callback != NULL)                                                                   /* if status callback */
+    {
+        handle->irq_status_callback(status);                                                                   /* run callback once */
+    }
+    hop = 0;                                                                                                   /* init hop result */
+    if ((handle->hop_enable != 0) && 
+        (((status & (SX1268_IRQ_TX_DONE | SX1268_IRQ_TIMEOUT)) != 0) || 
+         (((status & SX1268_IRQ_RX_DONE) != 0) && (handle->rx_continuous == 0))) &&
+        (handle->state != SX1268_CHIP_STATE_TX) && (handle->state != SX1268_CHIP_STATE_RX) && 
+        (handle->state != SX1268_CHIP_STATE_CAD))                                                              /* hop on completion */
+    {
+        hop = a_sx1268_hop_next(handle);                                                                       /* retune */
+        if (hop != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: hop failed.\n");                                                      /* hop failed */
+        }
+    }
+    if ((handle->tx_queue_active != 0) && ((status & (SX1268_IRQ_TX_DONE | SX1268_IRQ_TIMEOUT)) != 0))         /* queued frame finished */
+    {
+        res = a_sx1268_tx_queue_dispatch(handle);                                                              /* send the next frame */
+        if (res != 0)                                                                                          /* check result */
+        {
+            handle->debug_print("sx1268: tx queue dispatch failed.\n");                                        /* tx queue dispatch failed */
+           
+            return 1;                                                                                          /* return error */
+        }
+    }
+    
+    if (hop != 0)                                                                                              /* check the hop result */
+    {
+        return 1;                                                                                              /* return error */
+    }
+    
+    return 0;                                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     process the irq in the irq context
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] timestamp is the irq time in us
+ * @param[in] status_mask is the handled irq mask or the known irq status
+ * @param[in] status_known is the known irq status flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      commands sent while the irq is processed are not captured
+ */
+static uint8_t a_sx1268_irq_process(sx1268_handle_t *handle, uint32_t timestamp, uint16_t status_mask, uint8_t status_known)
+{
+    uint8_t res;
+    
+    handle->irq_active = 1;                                                             /* enter the irq context */
+    res = a_sx1268_irq_process_status(handle, timestamp, status_mask, status_known);    /* process */
+    handle->irq_active = 0;                                                             /* leave the irq context */
+    
+    return res;                                                                         /* return the result */
+}
+
+/**
+ * @brief     record an irq event
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] line is the dio line which fired, 0xFF is unknown
+ * @return    status code
+ *            - 0 success
+ *            - 5 event queue is full
+ * @note      it is isr safe, a lost event is marked so the bottom half reads the whole irq status
+ */
+static uint8_t a_sx1268_irq_top_half(sx1268_handle_t *handle, uint8_t line)
+{
+    uint8_t tail;
+    uint32_t timestamp;
+    
+    tail = handle->irq_event_tail;                                                         /* get tail */
+    if ((uint8_t)(tail - handle->irq_event_head) >= SX1268_IRQ_EVENT_QUEUE_DEPTH)          /* check space */
+    {
+        handle->irq_event_overflow++;                                                      /* count overflow */
+        handle->irq_event_lost = 1;                                                        /* run the full irq in the bottom half */
+        
+        return 5;                                                                          /* return error */
+    }
+    timestamp = 0;                                                                         /* no timestamp */
+    if (handle->get_time_us != NULL)                                                       /* check link */
+    {
+        if (handle->get_time_us((uint32_t *)&timestamp) != 0)                              /* stamp the edge */
+        {
+            timestamp = 0;                                                                 /* no timestamp */
+        }
+    }
+    handle->irq_event_time[tail & (SX1268_IRQ_EVENT_QUEUE_DEPTH - 1)] = timestamp;         /* save timestamp */
+    handle->irq_event_line[tail & (SX1268_IRQ_EVENT_QUEUE_DEPTH - 1)] = line;              /* save line */
+    SX1268_IRQ_EVENT_BARRIER();                                                            /* write the event before tail */
+    handle->irq_event_tail = tail + 1;                                                     /* publish */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     process the irq of one dio line
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] timestamp is the irq time in us
+ * @param[in] line is the dio line which fired
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      a line with only one irq skips the irq status read and clears every bit which is not
+ *            routed to another line
+ */
+static uint8_t a_sx1268_irq_line_process(sx1268_handle_t *handle, uint32_t timestamp, uint8_t line)
+{
+    uint16_t mask;
+    uint16_t routed;
+    
+    mask = handle->irq_line_mask[line] & handle->irq_mask;                                       /* irqs of this line */
+    if ((mask != 0) && ((mask & (mask - 1)) == 0) &&
+        ((mask != SX1268_IRQ_RX_DONE) || ((handle->irq_mask & SX1268_IRQ_CRC_ERR) == 0)))       /* only one irq on this line */
+    {
+        return a_sx1268_irq_process(handle, timestamp, mask, 1);                                 /* process the known irq */
+    }
+    routed = handle->irq_line_mask[0] | handle->irq_line_mask[1] | handle->irq_line_mask[2];     /* irqs on any line */
+    
+    return a_sx1268_irq_process(handle, timestamp, mask | (uint16_t)(~routed), 0);               /* process this line */
+}
+
+/**
+ * @brief     run the deferred irq events
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[out] *num points to a processed event number buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      after an event was dropped on a full queue the whole irq status is read and cleared once,
+ *            so a dio line held high by the lost irq is released
+ */
+static uint8_t a_sx1268_irq_bottom_half(sx1268_handle_t *handle, uint8_t *num)
+{
+    uint8_t res;
+    uint8_t head;
+    uint8_t line;
+    uint32_t timestamp;
+    
+    *num = 0;                                                                               /* init 0 */
+    head = handle->irq_event_head;                                                          /* get head */
+    while (head != handle->irq_event_tail)                                                  /* pending event */
+    {
+        SX1268_IRQ_EVENT_BARRIER();                                                         /* read the event after tail */
+        timestamp = handle->irq_event_time[head & (SX1268_IRQ_EVENT_QUEUE_DEPTH - 1)];      /* get timestamp */
+        line = handle->irq_event_line[head & (SX1268_IRQ_EVENT_QUEUE_DEPTH - 1)];           /* get line */
+        head++;                                                                             /* next event */
+        handle->irq_event_head = head;                                                      /* release the event */
+        (*num)++;                                                                           /* count */
+        if (line > SX1268_DIO_LINE_3)                                                       /* unknown line */
+        {
+            res = a_sx1268_irq_process(handle, timestamp, 0xFFFF, 0);                       /* process */
+        }
+        else
+        {
+            res = a_sx1268_irq_line_process(handle, timestamp, line);                       /* process the line */
+        }
+        if (res != 0)                                                                       /* check result */
+        {
+            return 1;                                                                       /* return error */
+        }
+    }
+    if (handle->irq_event_lost != 0)                                                        /* an event was lost */
+    {
+        handle->irq_event_lost = 0;                                                         /* clear the flag */
+        SX1268_IRQ_EVENT_BARRIER();                                                         /* clear the flag before the read */
+        (*num)++;                                                                           /* count */
+        if (a_sx1268_irq_process(handle, 0, 0xFFFF, 0) != 0)                                /* read and clear all irqs */
+        {
+            return 1;                                                                       /* return error */
+        }
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t sx1268_irq_handler(sx1268_handle_t *handle)
+{
+    uint32_t timestamp;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    timestamp = 0;                                                                         /* no timestamp */
+    if ((handle->rx_packet_callback != NULL) && (handle->get_time_us != NULL))             /* check links */
+    {
+        if (handle->get_time_us((uint32_t *)&timestamp) != 0)                              /* stamp the irq */
+        {
+            timestamp = 0;                                                                 /* no timestamp */
+        }
+    }
+    
+    return a_sx1268_irq_process(handle, timestamp, 0xFFFF, 0);                            /* process the irq */
+}
+
+/**
+ * @brief     irq top half
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 event queue is full
+ * @note      it is isr safe and only records the edge time, no spi transfer is done,
+ *            a full queue loses the event, the next bottom half then reads and clears the whole
+ *            irq status once, so a dio line held high by the lost irq is released
+ */
+uint8_t sx1268_irq_top_half(sx1268_handle_t *handle)
+{
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    return a_sx1268_irq_top_half(handle, 0xFF);                                           /* record an unknown line */
+}
+
+/**
+ * @brief     irq top half of one dio line
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] line is the dio line which fired
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 event queue is full
+ *            - 6 line is invalid
+ * @note      it is isr safe, sx1268_irq_bottom_half handles the event like sx1268_irq_line_handler
+ */
+uint8_t sx1268_irq_line_top_half(sx1268_handle_t *handle, sx1268_dio_line_t line)
+{
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (line > SX1268_DIO_LINE_3)                                                          /* check line */
+    {
+        return 6;                                                                          /* return error */
+    }
+    
+    return a_sx1268_irq_top_half(handle, (uint8_t)line);                                  /* record the line */
+}
+
+/**
+ * @brief      irq bottom half
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *num points to a processed event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       run it from the main loop or a work queue, it does all spi transfers of the
+ *             events recorded by sx1268_irq_top_half and runs the callbacks, after an event was
+ *             lost on a full queue the whole irq status is read and cleared once more
+ */
+uint8_t sx1268_irq_bottom_half(sx1268_handle_t *handle, uint8_t *num)
+{
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    return a_sx1268_irq_bottom_half(handle, num);                                         /* run the events */
+}
+
+/**
+ * @brief      get the irq event overflow counter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *count points to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_irq_event_overflow(sx1268_handle_t *handle, uint32_t *count)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *count = handle->irq_event_overflow;                 /* get counter */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     irq handler of one dio line
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] line is the dio line which fired
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 line is invalid
+ * @note      if the line only carries one irq the cause is known, the irq status is not read and
+ *            every bit not routed to another line is cleared, else the status is read and only the
+ *            bits of this line and the bits routed to no line are handled,
+ *            rx done is only known when SX1268_IRQ_CRC_ERR is not enabled, so the skip trades the
+ *            crc check away: a payload with a crc error is delivered as a valid rx done,
+ *            keep SX1268_IRQ_CRC_ERR enabled when corrupt payloads must be dropped
+ */
+uint8_t sx1268_irq_line_handler(sx1268_handle_t *handle, sx1268_dio_line_t line)
+{
+    uint32_t timestamp;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (line > SX1268_DIO_LINE_3)                                                                /* check line */
+    {
+        handle->debug_print("sx1268: line is invalid.\n");                                       /* line is invalid */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    timestamp = 0;                                                                               /* no timestamp */
+    if ((handle->rx_packet_callback != NULL) && (handle->get_time_us != NULL))                   /* check links */
+    {
+        if (handle->get_time_us((uint32_t *)&timestamp) != 0)                                    /* stamp the irq */
+        {
+            timestamp = 0;                                                                       /* no timestamp */
+        }
+    }
+    
+    return a_sx1268_irq_line_process(handle, timestamp, (uint8_t)line);                         /* process the line */
+}
+
+/**
+ * @brief     set the irq profile
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] profile is the irq profile
+ * @param[in] irq_mask is the enabled irq mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 set irq profile failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      all bits of irq_mask are latched in the irq status, with the completion profile only
+ *            SX1268_IRQ_COMPLETION_MASK is routed to dio1 and the other bits are read with the completion irq,
+ *            the multi line profile routes rx done alone to dio1 and the other completion irqs to dio2,
+ *            so dio2 can't be used as the rf switch control and tx done only skips the irq status read
+ *            when SX1268_IRQ_TIMEOUT and SX1268_IRQ_CAD_DONE are not enabled
+ */
+uint8_t sx1268_set_irq_profile(sx1268_handle_t *handle, sx1268_irq_profile_t profile, uint16_t irq_mask)
+{
+    uint8_t res;
+    uint8_t buf[8];
+    uint16_t dio1_mask;
+    uint16_t dio2_mask;
+    uint16_t dio3_mask;
+    
+    if (handle == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                            /* check busy */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                           /* chip is busy */
+       
+        return 4;                                                                                 /* return error */
+    }
+    
+    dio2_mask = 0x0000;                                                                           /* no dio2 irq */
+    dio3_mask = 0x0000;                                                                           /* no dio3 irq */
+    if (profile == SX1268_IRQ_PROFILE_COMPLETION)                                                 /* completion only */
+    {
+        dio1_mask = irq_mask & SX1268_IRQ_COMPLETION_MASK;                                        /* route completion irqs */
+    }
+    else if (profile == SX1268_IRQ_PROFILE_MULTI_LINE)                                            /* rx done on its own line */
+    {
+        dio1_mask = irq_mask & SX1268_IRQ_RX_DONE;                                                /* rx done on dio1 */
+        dio2_mask = irq_mask & SX1268_IRQ_COMPLETION_MASK & (uint16_t)(~SX1268_IRQ_RX_DONE);      /* tx done, timeout and cad done on dio2 */
+    }
+    else
+    {
+        dio1_mask = irq_mask;                                                                     /* route all irqs */
+    }
+    buf[0] = (irq_mask >> 8) & 0xFF;                                                              /* set param */
+    buf[1] = (irq_mask >> 0) & 0xFF;                                                              /* set param */
+    buf[2] = (dio1_mask >> 8) & 0xFF;                                                             /* set param */
+    buf[3] = (dio1_mask >> 0) & 0xFF;                                                             /* set param */
+    buf[4] = (dio2_mask >> 8) & 0xFF;                                                             /* set param */
+    buf[5] = (dio2_mask >> 0) & 0xFF;                                                             /* set param */
+    buf[6] = (dio3_mask >> 8) & 0xFF;                                                             /* set param */
+    buf[7] = (dio3_mask >> 0) & 0xFF;                                                             /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_DIO_IRQ_PARAMS, (uint8_t *)buf, 8);       /* write command */
+    if (res != 0)                                                                                 /* check result */
+    {
+        handle->debug_print("sx1268: set dio irq params failed.\n");                              /* set dio irq params failed */
+       
+        return 1;                                                                                 /* return error */
+    }
+    handle->irq_profile = (uint8_t)profile;                                                       /* save profile */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the irq profile
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *profile points to an irq profile buffer
+ * @param[out] *irq_mask points to an enabled irq mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the values are the last ones sent to the chip, no bus access is done
+ */
+uint8_t sx1268_get_irq_profile(sx1268_handle_t *handle, sx1268_irq_profile_t *profile, uint16_t *irq_mask)
+{
+    if (handle == NULL)                                         /* check handle */
+    {
+        return 2;                                               /* return error */
+    }
+    if (handle->inited != 1)                                    /* check handle initialization */
+    {
+        return 3;                                               /* return error */
+    }
+    
+    *profile = (sx1268_irq_profile_t)(handle->irq_profile);     /* get profile */
+    *irq_mask = handle->irq_mask;                               /* get irq mask */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the host interrupt statistics
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *irq_num points to a host interrupt number buffer
+ * @param[out] *packet_num points to a tx and rx packet number buffer
+ * @param[out] *irq_per_packet points to a host interrupt number of the last packet buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the average host interrupts per packet is irq_num / packet_num
+ */
+uint8_t sx1268_get_irq_statistics(sx1268_handle_t *handle, uint32_t *irq_num, uint32_t *packet_num, uint16_t *irq_per_packet)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *irq_num = handle->irq_stat_irq;                     /* get interrupt number */
+    *packet_num = handle->irq_stat_packet;               /* get packet number */
+    *irq_per_packet = handle->irq_stat_last;             /* get last packet interrupts */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 reset gpio initialization failed
+ *            - 5 busy gpio initialization failed
+ *            - 6 reset chip failed
+ * @note      none
+ */
+uint8_t sx1268_init(sx1268_handle_t *handle)
+{
+    uint8_t buf[2];
+    uint8_t prev;
+    uint8_t timer;
+    uint32_t start;
+    uint32_t stop;
+    uint32_t estimate;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->debug_print == NULL)                                                       /* check debug_print */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (handle->spi_init == NULL)                                                          /* check spi_init */
+    {
+        handle->debug_print("sx1268: spi_init is null.\n");                                /* spi_init is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->spi_deinit == NULL)                                                        /* check spi_deinit */
+    {
+        handle->debug_print("sx1268: spi_deinit is null.\n");                              /* spi_deinit is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->spi_write_read == NULL)                                                    /* check spi_write_read */
     {
         handle->debug_print("sx1268: spi_write_read is null.\n");                          /* spi_write_read is null */
        
-        return 3;                                                                          /* return error */
+        return 3;                                                                          /* return error */
+    }
+    if (handle->reset_gpio_init == NULL)                                                   /* check reset_gpio_init */
+    {
+        handle->debug_print("sx1268: reset_gpio_init is null.\n");                         /* reset_gpio_init is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->reset_gpio_deinit == NULL)                                                 /* check reset_gpio_deinit */
+    {
+        handle->debug_print("sx1268: reset_gpio_deinit is null.\n");                       /* reset_gpio_deinit is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->reset_gpio_write == NULL)                                                  /* check reset_gpio_write */
+    {
+        handle->debug_print("sx1268: reset_gpio_write is null.\n");                        /* reset_gpio_write is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->busy_gpio_init == NULL)                                                    /* check busy_gpio_init */
+    {
+        handle->debug_print("sx1268: busy_gpio_init is null.\n");                          /* busy_gpio_init is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->busy_gpio_deinit == NULL)                                                  /* check busy_gpio_deinit */
+    {
+        handle->debug_print("sx1268: busy_gpio_deinit is null.\n");                        /* busy_gpio_deinit is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->busy_gpio_read == NULL)                                                    /* check busy_gpio_read */
+    {
+        handle->debug_print("sx1268: busy_gpio_read is null.\n");                          /* busy_gpio_read is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->delay_ms == NULL)                                                          /* check delay_ms */
+    {
+        handle->debug_print("sx1268: delay_ms is null.\n");                                /* delay_ms is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    if (handle->receive_callback == NULL)                                                  /* check receive_callback */
+    {
+        handle->debug_print("sx1268: receive_callback is null.\n");                        /* receive_callback is null */
+       
+        return 3;                                                                          /* return error */
+    }
+    
+    if (handle->spi_init() != 0)                                                           /* spi initialization */
+    {
+        handle->debug_print("sx1268: spi initialization failed.\n");                       /* spi initialization failed */
+       
+        return 1;                                                                          /* return error */ 
+    }
+    if (handle->reset_gpio_init() != 0)                                                    /* reset gpio initialization */
+    {
+        handle->debug_print("sx1268: reset gpio initialization failed.\n");                /* reset gpio initialization failed */
+        (void)handle->spi_deinit();                                                        /* spi deinit */
+        
+        return 4;                                                                          /* return error */ 
+    }
+    if (handle->busy_gpio_init() != 0)                                                     /* busy gpio initialization */
+    {
+        handle->debug_print("sx1268: busy gpio initialization failed.\n");                 /* busy gpio initialization failed */
+        (void)handle->spi_deinit();                                                        /* spi deinit */
+        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
+        
+        return 5;                                                                          /* return error */ 
+    }
+    
+    handle->state = SX1268_CHIP_STATE_UNKNOWN;                                             /* unknown state */
+    handle->fallback_state = SX1268_CHIP_STATE_STANDBY_RC;                                 /* default fallback mode */
+    handle->rx_continuous = 0;                                                             /* no rx */
+    handle->cad_exit_rx = 0;                                                               /* cad only */
+    handle->status = 0;                                                                    /* clear the status */
+    handle->command_error_cnt = 0;                                                         /* clear the command error counter */
+    handle->busy_spin = SX1268_BUSY_DEFAULT_SPIN;                                          /* set the default spin */
+    handle->busy_step_us = SX1268_BUSY_DEFAULT_STEP_US;                                    /* set the default step */
+    handle->busy_timeout_us = SX1268_BUSY_DEFAULT_TIMEOUT_US;                              /* set the default timeout */
+    handle->busy_time_us = 0;                                                              /* clear the busy time */
+    handle->busy_time_max_us = 0;                                                          /* clear the max busy time */
+    handle->batch = 0;                                                                     /* no batch */
+    handle->batch_num = 0;                                                                 /* clear the batch */
+    handle->batch_len = 0;                                                                 /* clear the batch */
+    handle->reg_cache_enable = 0;                                                          /* disable the register cache */
+    handle->reg_cache_valid = 0;                                                           /* the reset clears the registers */
+    handle->reg_cache_lost = 0;                                                            /* nothing to restore */
+    handle->retention_num = 0;                                                             /* the reset clears the retention list */
+    handle->hop_table = NULL;                                                              /* no hop table */
+    handle->hop_num = 0;                                                                   /* no hop channel */
+    handle->hop_enable = 0;                                                                /* no hop */
+    handle->operation = SX1268_OPERATION_NONE;                                             /* no operation */
+    handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                               /* set idle */
+    handle->irq_fast = 0;                                                                  /* normal irq path */
+    handle->irq_event_head = 0;                                                            /* reset head */
+    handle->irq_event_tail = 0;                                                            /* reset tail */
+    handle->irq_event_overflow = 0;                                                        /* reset overflow */
+    handle->irq_event_lost = 0;                                                            /* no lost event */
+    handle->irq_profile = SX1268_IRQ_PROFILE_ALL;                                          /* all irqs on dio1 */
+    handle->irq_mask = 0x0000;                                                             /* no irq */
+    handle->irq_line_mask[0] = 0x0000;                                                     /* no dio1 irq */
+    handle->irq_line_mask[1] = 0x0000;                                                     /* no dio2 irq */
+    handle->irq_line_mask[2] = 0x0000;                                                     /* no dio3 irq */
+    handle->irq_stat_irq = 0;                                                              /* reset statistics */
+    handle->irq_stat_packet = 0;                                                           /* reset statistics */
+    handle->irq_stat_since = 0;                                                            /* reset statistics */
+    handle->irq_stat_last = 0;                                                             /* reset statistics */
+    memset(handle->irq_handler, 0, sizeof(handle->irq_handler));                           /* no irq handler */
+    handle->irq_status_callback = NULL;                                                    /* no status callback */
+    handle->irq_handler_mask = 0;                                                          /* no irq handler */
+    handle->irq_table = 0;                                                                 /* use the receive callback */
+    handle->tx_queue_enable = 0;                                                           /* no tx queue */
+    handle->tx_queue_active = 0;                                                           /* nothing on air */
+    handle->tx_queue_retry = 0;                                                            /* no frame to resend */
+    handle->rx_ring_buf = NULL;                                                            /* no rx ring */
+    handle->rx_ring_head = 0;                                                              /* reset head */
+    handle->rx_ring_tail = 0;                                                              /* reset tail */
+    handle->rx_ring_overflow = 0;                                                          /* reset overflow */
+    handle->rx_filter_match = NULL;                                                        /* no match */
+    handle->rx_filter_enable = 0;                                                          /* disable the rx filter */
+    handle->rx_filter_header_len = 1;                                                      /* 1 byte header */
+    handle->rx_filter_address_offset = 0;                                                  /* address first */
+    memset(handle->rx_filter_map, 0, sizeof(uint8_t) * 32);                                /* no address */
+    handle->rx_filter_dropped = 0;                                                         /* reset counter */
+    handle->rx_buffer_provider = NULL;                                                     /* inner receive buffer */
+    handle->rx_buffer_release = NULL;                                                      /* no release */
+    handle->rx_buffer_dropped = 0;                                                         /* reset counter */
+    handle->tx_base = 0x00;                                                                /* reset tx base address */
+    handle->packet_type = SX1268_PACKET_TYPE_GFSK;                                         /* gfsk after reset */
+    handle->rx_base = 0x00;                                                                /* reset rx base address */
+    handle->tx_pipe_next = 0;                                                              /* stage into the first half */
+    handle->tx_pipe_staged = 0;                                                            /* no staged frame */
+    handle->tx_pipe_len = 0;                                                               /* no staged frame */
+    handle->hop_image[0] = 0;                                                              /* no calibrated image */
+    handle->hop_image[1] = 0;                                                              /* no calibrated image */
+    handle->config_diff = 0;                                                               /* disable the configuration diff */
+    handle->config_force = 0;                                                              /* no force */
+    handle->config_valid = 0;                                                              /* the reset clears the configuration */
+    handle->capture = 0;                                                                   /* no capture */
+    handle->irq_active = 0;                                                                /* not in the irq context */
+    handle->capture_overflow = 0;                                                          /* clear the overflow flag */
+    
+    handle->start_time_us = 0;                                                             /* clear the start time */
+    if ((handle->get_time_us == NULL) || (handle->get_time_us(&start) != 0))               /* get the start time */
+    {
+        start = 0;                                                                         /* no timer */
+        timer = 0;                                                                         /* estimate the time */
+    }
+    else
+    {
+        timer = 1;                                                                         /* measure the time */
+    }
+    if (handle->fast_start == 0)                                                           /* normal start */
+    {
+        if (handle->reset_gpio_write(1) != 0)                                              /* set high */
+        {
+            handle->debug_print("sx1268: reset chip failed.\n");                           /* reset chip failed */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */ 
+        }
+        handle->delay_ms(5);                                                               /* delay 5 ms */
+        if (handle->reset_gpio_write(0) != 0)                                              /* set low */
+        {
+            handle->debug_print("sx1268: reset chip failed.\n");                           /* reset chip failed */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */ 
+        }
+        handle->delay_ms(10);                                                              /* delay 5 ms */
+        if (handle->reset_gpio_write(1) != 0)                                              /* set high */
+        {
+            handle->debug_print("sx1268: reset chip failed.\n");                           /* reset chip failed */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */ 
+        }
+        handle->delay_ms(5);                                                               /* delay 5 ms */
+        estimate = 20000;                                                                  /* 20 ms */
+    }
+    else
+    {
+        if (handle->reset_gpio_write(0) != 0)                                              /* set low */
+        {
+            handle->debug_print("sx1268: reset chip failed.\n");                           /* reset chip failed */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */ 
+        }
+        if (handle->delay_us != NULL)                                                      /* if delay us */
+        {
+            handle->delay_us(SX1268_FAST_START_RESET_PULSE_US);                            /* shortest reset pulse */
+            estimate = SX1268_FAST_START_RESET_PULSE_US;                                   /* set the estimate */
+        }
+        else
+        {
+            handle->delay_ms(1);                                                           /* delay 1 ms */
+            estimate = 1000;                                                               /* set the estimate */
+        }
+        if (handle->reset_gpio_write(1) != 0)                                              /* set high */
+        {
+            handle->debug_print("sx1268: reset chip failed.\n");                           /* reset chip failed */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */ 
+        }
+        if (a_sx1268_check_busy(handle) != 0)                                              /* wait for the busy falling edge */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                                /* chip is busy */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */
+        }
+        estimate += handle->busy_time_us;                                                  /* add the busy time */
+    }
+    
+    if (a_sx1268_spi_read(handle, SX1268_COMMAND_GET_STATUS, (uint8_t *)buf, 2) != 0)      /* read command */
+    {
+        handle->debug_print("sx1268: get status failed.\n");                               /* get status failed */
+        (void)handle->spi_deinit();                                                        /* spi deinit */
+        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
+        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
+        
+        return 6;                                                                          /* return error */
+    }
+    prev = 0x00;
+    if (a_sx1268_spi_write(handle, SX1268_COMMAND_SET_STANDBY, (uint8_t *)&prev, 1) != 0)  /* write command */
+    {
+        handle->debug_print("sx1268: set standby failed.\n");                              /* set standby failed */
+        (void)handle->spi_deinit();                                                        /* spi deinit */
+        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
+        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
+        
+        return 6;                                                                          /* return error */
+    }
+    if (handle->fast_start != 0)                                                           /* fast start */
+    {
+        if (a_sx1268_check_busy(handle) != 0)                                              /* wait for the standby */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                                /* chip is busy */
+            (void)handle->spi_deinit();                                                    /* spi deinit */
+            (void)handle->reset_gpio_deinit();                                             /* reset gpio deinit */
+            (void)handle->busy_gpio_deinit();                                              /* busy gpio deinit */
+            
+            return 6;                                                                      /* return error */
+        }
+        estimate += handle->busy_time_us;                                                  /* add the busy time */
+    }
+    if ((timer != 0) && (handle->get_time_us(&stop) == 0))                                 /* get the stop time */
+    {
+        handle->start_time_us = stop - start;                                              /* measured time */
+    }
+    else
+    {
+        handle->start_time_us = estimate;                                                  /* estimated time */
+    }
+    handle->inited = 1;                                                                    /* flag finish initialization */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 power down failed
+ *            - 6 busy gpio deinit failed
+ *            - 7 reset gpio deinit failed
+ * @note      none
+ */
+uint8_t sx1268_deinit(sx1268_handle_t *handle)
+{
+    uint8_t res, prev;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    handle->batch = 0;                                                                     /* drop the batch */
+    handle->batch_num = 0;                                                                 /* drop the batch */
+    handle->batch_len = 0;                                                                 /* drop the batch */
+    res = a_sx1268_check_busy(handle);                                                     /* check busy */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                    /* chip is busy */
+       
+        return 4;                                                                          /* return error */
+    }
+    
+    prev = 0x00;                                                                           /* set power down */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_SLEEP, (uint8_t *)&prev, 1);       /* write command */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: power down failed.\n");                               /* power down failed */
+       
+        return 5;                                                                          /* return error */
+    }
+    
+    res = handle->busy_gpio_deinit();                                                      /* busy gpio deinit */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: busy gpio deinit failed.\n");                         /* busy gpio deinit failed */
+       
+        return 6;                                                                          /* return error */
+    }
+    res = handle->reset_gpio_deinit();                                                     /* reset gpio deinit */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: reset gpio deinit failed.\n");                        /* reset gpio deinit failed */
+       
+        return 7;                                                                          /* return error */
+    }
+    res = handle->spi_deinit();                                                            /* spi deinit */
+    if (res != 0)                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: spi deinit failed.\n");                               /* spi deinit failed */
+       
+        return 1;                                                                          /* return error */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     enter to the single receive mode with a raw timeout
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] timeout is the rx timeout register raw data
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora single receive failed
+ *            - 4 chip is busy
+ * @note      none
+ */
+static uint8_t a_sx1268_single_receive(sx1268_handle_t *handle, uint32_t timeout)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    uint16_t clear_irq_param;
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    clear_irq_param = 0x03FF;                                                                   /* set mask */
+    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
+    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    buf[0] = (timeout >> 16) & 0xFF;                                                            /* bit 23 : 16 */
+    buf[1] = (timeout >> 8) & 0xFF;                                                             /* bit 15 : 8 */
+    buf[2] = (timeout >> 0) & 0xFF;                                                             /* bit 7 : 0 */
+    handle->operation = SX1268_OPERATION_RX;                                                    /* set operation */
+    handle->operation_status = SX1268_OPERATION_STATUS_RUNNING;                                 /* wait for the irq */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_RX, (uint8_t *)buf, 3);                 /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: set rx failed.\n");                                        /* set rx failed */
+        handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                                /* not started */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+#if (SX1268_FLOAT_API == 1)
+/**
+ * @brief     enter to the single receive mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora single receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_single_receive(sx1268_handle_t *handle, double us)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    return a_sx1268_single_receive(handle, (uint32_t)(us / 15.625));         /* single receive */
+}
+#endif
+
+/**
+ * @brief     enter to the single receive mode with an integer timeout
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora single receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_single_receive_integer(sx1268_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    return a_sx1268_single_receive(handle, 
+                                   (uint32_t)(((uint64_t)us * 8) / 125));    /* single receive */
+}
+
+/**
+ * @brief     enter to the continuous receive mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora continuous receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_continuous_receive(sx1268_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t clear_irq_param;
+    uint8_t buf[3];
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    clear_irq_param = 0x03FF;                                                                   /* set mask */
+    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
+    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    buf[0] = 0xFF;                                                                              /* bit 23 : 16 */
+    buf[1] = 0xFF;                                                                              /* bit 15 : 8 */
+    buf[2] = 0xFF;                                                                              /* bit 7 : 0 */
+    handle->operation = SX1268_OPERATION_NONE;                                                  /* no completion to track */
+    handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                                    /* set idle */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_RX, (uint8_t *)buf, 3);                 /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: set rx failed.\n");                                        /* set rx failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     lora cad start helper
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora cad failed
+ *            - 4 chip is busy
+ * @note      none
+ */
+static uint8_t a_sx1268_lora_cad_start(sx1268_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t clear_irq_param;
+    uint8_t buf[2];
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    clear_irq_param = 0x03FF;                                                                   /* set mask */
+    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
+    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    handle->cad_done = 0;                                                                       /* clear cad done */
+    handle->cad_detected = 0;                                                                   /* clear cad done */
+    handle->operation = SX1268_OPERATION_CAD;                                                   /* set operation */
+    handle->operation_status = SX1268_OPERATION_STATUS_RUNNING;                                 /* wait for the irq */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_CAD, NULL, 0);                          /* write command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: set cad failed.\n");                                       /* set cad failed */
+        handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                                /* not started */
+       
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      run the cad
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a enable buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lora cad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 cad timeout
+ * @note       none
+ */
+uint8_t sx1268_lora_cad(sx1268_handle_t *handle, sx1268_bool_t *enable)
+{
+    uint8_t res;
+    uint16_t timeout;
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+
+    res = a_sx1268_lora_cad_start(handle);                                                      /* start cad */
+    if (res != 0)                                                                               /* check result */
+    {
+        return res;                                                                             /* return error */
+    }
+    
+    timeout = 10000;                                                                            /*  set timeout */
+    while ((timeout != 0) && (handle->cad_done == 0))                                           /* wait */
+    {
+        uint8_t num;
+        
+        if (a_sx1268_irq_bottom_half(handle, &num) != 0)                                        /* run the deferred irq */
+        {
+            return 1;                                                                           /* return error */
+        }
+        if (handle->cad_done != 0)                                                              /* check the flag */
+        {
+            break;                                                                              /* break */
+        }
+        handle->delay_ms(1);                                                                    /* delay 1 ms */
+        timeout--;                                                                              /* timeout-- */
+    }
+    if (timeout == 0)                                                                           /* check timeout */
+    {
+        handle->debug_print("sx1268: cad timeout.\n");                                          /* cad timeout */
+       
+        return 5;                                                                               /* return error */
+    }
+    if (handle->cad_detected == 1)                                                              /* set cad */
+    {
+        *enable = SX1268_BOOL_TRUE;                                                             /* enable */
+    }
+    else
+    {
+        *enable = SX1268_BOOL_FALSE;                                                            /* disable */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      check the packet error
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_check_packet_error(sx1268_handle_t *handle, sx1268_bool_t *enable)
+{
+    if (handle == NULL)                                  /* check handle */
+    {
+        return 2;                                        /* return error */
+    }
+    if (handle->inited != 1)                             /* check handle initialization */
+    {
+        return 3;                                        /* return error */
+    }
+    
+    *enable = (sx1268_bool_t)(handle->crc_error);        /* check error */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     sent the lora data
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 sent failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 sent timeout
+ *            - 6 irq timeout
+ *            - 7 unknown result
+ *            - 8 len is over the tx buffer
+ * @note      len must not be over 256 - tx base address
+ */
+uint8_t sx1268_lora_transmit(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                             uint16_t preamble_length, sx1268_lora_header_t header_type,
+                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
+                             uint8_t *buf, uint16_t len, uint32_t us)
+{
+    uint8_t res;
+    uint32_t ms;
+    
+    if (handle == NULL)                                                                                    /* check handle */
+    {
+        return 2;                                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                                               /* check handle initialization */
+    {
+        return 3;                                                                                          /* return error */
+    }
+    if (len > 256 - (uint16_t)handle->tx_base)                                                             /* check the tx buffer */
+    {
+        handle->debug_print("sx1268: len is over the tx buffer.\n");                                      /* len is over the tx buffer */
+       
+        return 8;                                                                                          /* return error */
+    }
+    
+    res = a_sx1268_lora_transmit_start(handle, standby_src, preamble_length, header_type,
+                                       crc_type, invert_iq_enable, buf, len, us);                          /* start transmit */
+    if (res != 0)                                                                                          /* check result */
+    {
+        return res;                                                                                        /* return error */
+    }
+    ms = us / 1000 + 10000;                                                                                /* set timeout */
+    while ((ms != 0) && (handle->tx_done == 0) && (handle->timeout == 0))                                  /* check timeout */
+    {
+        uint8_t num;
+        
+        if (a_sx1268_irq_bottom_half(handle, &num) != 0)                                                   /* run the deferred irq */
+        {
+            return 1;                                                                                      /* return error */
+        }
+        if ((handle->tx_done != 0) || (handle->timeout != 0))                                              /* check the flags */
+        {
+            break;                                                                                         /* break */
+        }
+        handle->delay_ms(1);                                                                               /* delay 1 ms */
+        ms--;                                                                                              /* ms-- */
+    }
+    if ((ms != 0) && (handle->tx_done == 1))                                                               /* check the result */
+    {
+        return 0;                                                                                          /* success return 0 */
+    }
+    else if ((ms == 0) & (handle->tx_done == 0))                                                           /* check the result */
+    {
+        handle->debug_print("sx1268: sent timeout.\n");                                                    /* sent timeout */
+       
+        return 5;                                                                                          /* return error */
+    }
+    else if (handle->timeout == 1)                                                                         /* check the result */
+    {
+        handle->debug_print("sx1268: irq timeout.\n");                                                     /* irq timeout */
+       
+        return 6;                                                                                          /* return error */
+    }
+    else
+    {
+        handle->debug_print("sx1268: unknown result.\n");                                                  /* unknown result */
+       
+        return 7;                                                                                          /* return error */
+    }
+}
+
+/**
+ * @brief     start sending the lora data without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 sent failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 len is over the tx buffer
+ * @note      returns right after SetTx, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status, len must not be over
+ *            256 - tx base address
+ */
+uint8_t sx1268_lora_transmit_start(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                                   uint16_t preamble_length, sx1268_lora_header_t header_type,
+                                   sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
+                                   uint8_t *buf, uint16_t len, uint32_t us)
+{
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    return a_sx1268_lora_transmit_start(handle, standby_src, preamble_length, header_type,
+                                        crc_type, invert_iq_enable, buf, len, us);           /* start transmit */
+}
+
+/**
+ * @brief     start the cad without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora cad failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      returns right after SetCad, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status
+ */
+uint8_t sx1268_lora_cad_start(sx1268_handle_t *handle)
+{
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 2;                                         /* return error */
+    }
+    if (handle->inited != 1)                              /* check handle initialization */
+    {
+        return 3;                                         /* return error */
+    }
+    
+    return a_sx1268_lora_cad_start(handle);               /* start cad */
+}
+
+/**
+ * @brief     start the single receive without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      returns right after SetRx, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status
+ */
+uint8_t sx1268_receive_start(sx1268_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    return a_sx1268_single_receive(handle, 
+                                   (uint32_t)(((uint64_t)us * 8) / 125));    /* start receive */
+}
+
+/**
+ * @brief      get the status of the last started operation
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *operation points to an operation buffer
+ * @param[out] *status points to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_operation_status(sx1268_handle_t *handle, sx1268_operation_t *operation,
+                                    sx1268_operation_status_t *status)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    *operation = (sx1268_operation_t)(handle->operation);                    /* get operation */
+    *status = (sx1268_operation_status_t)(handle->operation_status);         /* get status */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     write the register
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                  /* check busy */
+    if (res != 0)                                                       /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                 /* chip is busy */
+       
+        return 4;                                                       /* return error */
+    }
+    
+    if (a_sx1268_spi_write_register(handle, reg, buf, len) != 0)        /* write register */
+    {
+        handle->debug_print("sx1268: write register failed.\n");        /* write register failed */
+       
+        return 1;                                                       /* return error */
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read the register
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read register failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                 /* check busy */
+    if (res != 0)                                                      /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                /* chip is busy */
+       
+        return 4;                                                      /* return error */
+    }
+    
+    if (a_sx1268_spi_read_register(handle, reg, buf, len) != 0)        /* read register */
+    {
+        handle->debug_print("sx1268: read register failed.\n");        /* read register failed */
+       
+        return 1;                                                      /* return error */
+    }
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     write the buffer
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] offset is the buffer offset
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write buffer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                               /* check handle */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (handle->inited != 1)                                          /* check handle initialization */
+    {
+        return 3;                                                     /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                /* check busy */
+    if (res != 0)                                                     /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");               /* chip is busy */
+       
+        return 4;                                                     /* return error */
+    }
+    
+    if (a_sx1268_spi_write_buffer(handle, offset, buf, len) != 0)     /* write buffer */
+    {
+        handle->debug_print("sx1268: write buffer failed.\n");        /* write buffer failed */
+       
+        return 1;                                                     /* return error */
+    }
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      read the buffer
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  offset is the buffer offset
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read buffer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                              /* check handle */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (handle->inited != 1)                                         /* check handle initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                               /* check busy */
+    if (res != 0)                                                    /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");              /* chip is busy */
+       
+        return 4;                                                    /* return error */
+    }
+    
+    if (a_sx1268_spi_read_buffer(handle, offset, buf, len) != 0)     /* read buffer */
+    {
+        handle->debug_print("sx1268: read buffer failed.\n");        /* read buffer failed */
+       
+        return 1;                                                    /* return error */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     begin recording commands into a batch
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] gap_us is the gap between two commands in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      write commands are recorded until sx1268_batch_commit is called,
+ *            a read command commits the recorded commands before it runs,
+ *            with the spi_writev link the commands go out in one transfer without busy checks,
+ *            so gap_us is waited with the chip select high after every command and must cover
+ *            the busy time of the recorded commands
+ */
+uint8_t sx1268_batch_begin(sx1268_handle_t *handle, uint16_t gap_us)
+{
+    if (handle == NULL)                        /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    if (handle->inited != 1)                   /* check handle initialization */
+    {
+        return 3;                              /* return error */
+    }
+    
+    handle->batch_gap_us = gap_us;             /* set the gap */
+    handle->batch = 1;                         /* start recording */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     commit the recorded batch commands
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch commit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      with the spi_writev link all commands are sent in one bus operation, a read or a
+ *            check inside the batch flushes it first and splits it
+ */
+uint8_t sx1268_batch_commit(sx1268_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    handle->batch = 0;                                                   /* stop recording */
+    res = a_sx1268_check_busy(handle);                                   /* check busy */
+    if (res != 0)                                                        /* check result */
+    {
+        handle->batch_num = 0;                                           /* drop the batch */
+        handle->batch_len = 0;                                           /* drop the batch */
+        handle->debug_print("sx1268: chip is busy.\n");                  /* chip is busy */
+       
+        return 4;                                                        /* return error */
+    }
+    res = a_sx1268_batch_flush(handle);                                  /* flush the batch */
+    if (res != 0)                                                        /* check result */
+    {
+        handle->debug_print("sx1268: batch commit failed.\n");           /* batch commit failed */
+       
+        return 1;                                                        /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the busy wait strategy
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] spin is the busy pin poll times before yielding
+ * @param[in] step_us is the yield step in us
+ * @param[in] timeout_us is the busy wait deadline in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is invalid
+ * @note      step_us is used with the delay_us link, otherwise the wait yields by 1 ms
+ */
+uint8_t sx1268_set_busy_wait(sx1268_handle_t *handle, uint16_t spin, uint16_t step_us, uint32_t timeout_us)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    if ((step_us == 0) || (timeout_us == 0))                        /* check the param */
+    {
+        handle->debug_print("sx1268: param is invalid.\n");         /* param is invalid */
+        
+        return 5;                                                   /* return error */
+    }
+    
+    handle->busy_spin = spin;                                       /* set the spin */
+    handle->busy_step_us = step_us;                                 /* set the step */
+    handle->busy_timeout_us = timeout_us;                           /* set the timeout */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the busy wait strategy
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *spin points to a busy pin poll times buffer
+ * @param[out] *step_us points to a yield step buffer
+ * @param[out] *timeout_us points to a busy wait deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_busy_wait(sx1268_handle_t *handle, uint16_t *spin, uint16_t *step_us, uint32_t *timeout_us)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    
+    *spin = handle->busy_spin;                                      /* get the spin */
+    *step_us = handle->busy_step_us;                                /* get the step */
+    *timeout_us = handle->busy_timeout_us;                          /* get the timeout */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the fast start mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      call it before sx1268_init, the reset pulse is SX1268_FAST_START_RESET_PULSE_US
+ *            with the delay_us link and the chip is ready as soon as the busy pin falls
+ */
+uint8_t sx1268_set_fast_start(sx1268_handle_t *handle, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    handle->fast_start = (uint8_t)enable;               /* set the fast start */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the power on to standby time of the last sx1268_init
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *us points to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is measured with the get_time_us link, otherwise it is estimated
+ */
+uint8_t sx1268_get_start_time(sx1268_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    *us = handle->start_time_us;                        /* get the start time */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the measured busy wait time
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *last_us points to a last busy wait time buffer
+ * @param[out] *max_us points to a max busy wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is measured with the get_time_us link, otherwise it is estimated from the delays
+ */
+uint8_t sx1268_get_busy_time(sx1268_handle_t *handle, uint32_t *last_us, uint32_t *max_us)
+{
+    if (handle == NULL)                           /* check handle */
+    {
+        return 2;                                 /* return error */
+    }
+    if (handle->inited != 1)                      /* check handle initialization */
+    {
+        return 3;                                 /* return error */
+    }
+    
+    *last_us = handle->busy_time_us;              /* get the last time */
+    *max_us = handle->busy_time_max_us;           /* get the max time */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      get the chip state
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *state points to a chip state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the state is the last commanded mode updated by the irq handler,
+ *             a command sent in the sleep state wakes the chip up first
+ */
+uint8_t sx1268_get_chip_state(sx1268_handle_t *handle, sx1268_chip_state_t *state)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    if (handle->inited != 1)                                 /* check handle initialization */
+    {
+        return 3;                                            /* return error */
+    }
+    
+    *state = (sx1268_chip_state_t)(handle->state);           /* get the state */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the last status byte
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *status points to a raw status buffer
+ * @param[out] *mode points to a chip mode buffer
+ * @param[out] *cmd_status points to a command status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       no bus access is done, the status byte is only harvested from read transactions:
+ *             get commands, read register and read buffer, writes and batches don't update it,
+ *             call sx1268_get_status to sample it after a write
+ */
+uint8_t sx1268_get_last_status(sx1268_handle_t *handle, uint8_t *status, sx1268_chip_mode_t *mode,
+                               sx1268_command_status_t *cmd_status)
+{
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    
+    *status = handle->status;                                                         /* get the raw status */
+    *mode = (sx1268_chip_mode_t)((handle->status >> 4) & 0x07);                       /* get the chip mode */
+    *cmd_status = (sx1268_command_status_t)((handle->status >> 1) & 0x07);            /* get the command status */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      get the command error counter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *cnt points to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       command timeout, processing error and failure to execute are counted from the status
+ *             byte of read transactions only, the chip reports the status of the previous command,
+ *             so an error of a write is counted by the next read
+ */
+uint8_t sx1268_get_command_error_count(sx1268_handle_t *handle, uint32_t *cnt)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    *cnt = handle->command_error_cnt;                   /* get the counter */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is write through and is invalidated by this function, a reset and a cold sleep,
+ *            reads of the cached registers are served from ram once they are known
+ */
+uint8_t sx1268_set_register_cache(sx1268_handle_t *handle, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    handle->reg_cache_enable = (uint8_t)enable;         /* set the cache */
+    handle->reg_cache_valid = 0;                        /* clear the valid bits */
+    handle->reg_cache_lost = 0;                         /* clear the lost bits */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the configuration diff
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, set modulation params, set packet params, set rf frequency, set tx params,
+ *            set buffer base address, set standby and cached register writes identical to the last
+ *            applied values are not sent again
+ */
+uint8_t sx1268_set_config_diff(sx1268_handle_t *handle, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    handle->config_diff = (uint8_t)enable;              /* set the diff */
+    handle->config_valid = 0;                           /* clear the shadow */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the configuration force flag
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, every command is sent even if it is unchanged, use it to recover the
+ *            chip configuration after an unexpected reset
+ */
+uint8_t sx1268_set_config_force(sx1268_handle_t *handle, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    handle->config_force = (uint8_t)enable;             /* set the force flag */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      read a list of registers
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  *reg points to a register address list
+ * @param[out] *value points to a value buffer
+ * @param[in]  num is the register number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read registers failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 num is over SX1268_REGISTERS_MAX_NUM
+ * @note       value[i] is the value of reg[i], the addresses are sorted and adjacent
+ *             addresses are merged into one burst read
+ */
+uint8_t sx1268_read_registers(sx1268_handle_t *handle, uint16_t *reg, uint8_t *value, uint16_t num)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (num > SX1268_REGISTERS_MAX_NUM)                                        /* check the number */
+    {
+        handle->debug_print("sx1268: num is over %d.\n", 
+                            SX1268_REGISTERS_MAX_NUM);                         /* num is over max */
+        
+        return 5;                                                              /* return error */
+    }
+    
+    res = a_sx1268_spi_access_registers(handle, reg, value, num, 0);           /* read registers */
+    if (res == 4)                                                              /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                       /* chip is busy */
+        
+        return 4;                                                              /* return error */
+    }
+    else if (res != 0)                                                         /* check result */
+    {
+        handle->debug_print("sx1268: read register failed.\n");               /* read register failed */
+        
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     write a list of registers
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *reg points to a register address list
+ * @param[in] *value points to a value buffer
+ * @param[in] num is the register number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write registers failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is over SX1268_REGISTERS_MAX_NUM
+ * @note      value[i] is written to reg[i], the addresses are sorted and adjacent
+ *            addresses are merged into one burst write, a repeated address keeps the list order
+ */
+uint8_t sx1268_write_registers(sx1268_handle_t *handle, uint16_t *reg, uint8_t *value, uint16_t num)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (num > SX1268_REGISTERS_MAX_NUM)                                        /* check the number */
+    {
+        handle->debug_print("sx1268: num is over %d.\n", 
+                            SX1268_REGISTERS_MAX_NUM);                         /* num is over max */
+        
+        return 5;                                                              /* return error */
+    }
+    
+    res = a_sx1268_spi_access_registers(handle, reg, value, num, 1);           /* write registers */
+    if (res == 4)                                                              /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                       /* chip is busy */
+        
+        return 4;                                                              /* return error */
+    }
+    else if (res != 0)                                                         /* check result */
+    {
+        handle->debug_print("sx1268: write register failed.\n");              /* write register failed */
+        
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     begin capturing the applied configuration
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a stream buffer
+ * @param[in] size is the stream buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      configuration commands and register writes are appended to the stream in bus
+ *            order as opcode, length and params after they are sent, a repeated command or a
+ *            register write covering an older one drops the older entry, unchanged commands
+ *            are not skipped while capturing, mode commands such as sleep, standby, tx and rx
+ *            and commands sent by the irq handler are not captured
+ */
+uint8_t sx1268_config_capture_begin(sx1268_handle_t *handle, uint8_t *buf, uint16_t size)
+{
+    if (handle == NULL)                        /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    if (handle->inited != 1)                   /* check handle initialization */
+    {
+        return 3;                              /* return error */
+    }
+    
+    handle->capture_buf = buf;                 /* set the buffer */
+    handle->capture_size = size;               /* set the size */
+    handle->capture_len = 0;                   /* clear the length */
+    handle->capture_overflow = 0;              /* clear the overflow flag */
+    handle->capture = 1;                       /* start capturing */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      end capturing the applied configuration
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *len points to a stream length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 stream buffer is too small
+ * @note       the stream can be stored in flash or a file and used by sx1268_config_replay
+ */
+uint8_t sx1268_config_capture_end(sx1268_handle_t *handle, uint16_t *len)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
     }
-    if (handle->reset_gpio_init == NULL)                                                   /* check reset_gpio_init */
+    if (handle->inited != 1)                                             /* check handle initialization */
     {
-        handle->debug_print("sx1268: reset_gpio_init is null.\n");                         /* reset_gpio_init is null */
+        return 3;                                                        /* return error */
+    }
+    
+    handle->capture = 0;                                                 /* stop capturing */
+    *len = handle->capture_len;                                          /* get the length */
+    if (handle->capture_overflow != 0)                                   /* check the overflow flag */
+    {
+        handle->debug_print("sx1268: stream buffer is too small.\n");    /* stream buffer is too small */
+        
+        return 5;                                                        /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     replay a captured configuration stream
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a stream buffer
+ * @param[in] len is the stream length
+ * @param[in] gap_us is the gap between two commands in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 config replay failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 stream is invalid
+ *            - 6 batch is open
+ * @note      the stream is sent as batches with gap_us, the batch gap set by sx1268_batch_begin
+ *            is kept, the busy pin is only polled after the calibration and tcxo commands and
+ *            at the end of the stream, it can't run inside sx1268_batch_begin and sx1268_batch_commit
+ */
+uint8_t sx1268_config_replay(sx1268_handle_t *handle, uint8_t *buf, uint16_t len, uint16_t gap_us)
+{
+    uint8_t res;
+    uint16_t gap;
+    uint16_t pos;
+    uint16_t reg;
+    uint8_t *entry;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (handle->batch != 0)                                                                 /* check the batch */
+    {
+        handle->debug_print("sx1268: batch is open.\n");                                   /* batch is open */
+        
+        return 6;                                                                           /* return error */
+    }
+    
+    pos = 0;                                                                                /* init 0 */
+    while (pos < len)                                                                       /* check all entries */
+    {
+        entry = &buf[pos];                                                                  /* get the entry */
+        if (((pos + 2) > len) || ((pos + 2 + entry[1]) > len) ||
+            (a_sx1268_config_command(entry[0]) == 0) ||
+            ((entry[0] == SX1268_COMMAND_WRITE_REGISTER) && (entry[1] < 3)))                /* check the entry */
+        {
+            handle->debug_print("sx1268: stream is invalid.\n");                           /* stream is invalid */
+            
+            return 5;                                                                       /* return error */
+        }
+        pos += 2 + entry[1];                                                                /* next entry */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                      /* check busy */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                    /* chip is busy */
        
-        return 3;                                                                          /* return error */
+        return 4;                                                                           /* return error */
     }
-    if (handle->reset_gpio_deinit == NULL)                                                 /* check reset_gpio_deinit */
+    
+    gap = handle->batch_gap_us;                                                             /* save the gap */
+    handle->batch_gap_us = gap_us;                                                          /* set the gap */
+    handle->batch = 1;                                                                      /* start recording */
+    res = 0;                                                                                /* init 0 */
+    pos = 0;                                                                                /* init 0 */
+    while ((pos < len) && (res == 0))                                                       /* run all entries */
     {
-        handle->debug_print("sx1268: reset_gpio_deinit is null.\n");                       /* reset_gpio_deinit is null */
+        entry = &buf[pos];                                                                  /* get the entry */
+        if (entry[0] == SX1268_COMMAND_WRITE_REGISTER)                                      /* write register */
+        {
+            reg = ((uint16_t)entry[2] << 8) | entry[3];                                     /* get the register */
+            res = a_sx1268_spi_write_register(handle, reg, &entry[4], entry[1] - 2);        /* write register */
+        }
+        else
+        {
+            res = a_sx1268_spi_write(handle, entry[0], &entry[2], entry[1]);                /* write command */
+        }
+        if ((res == 0) && 
+            ((entry[0] == SX1268_COMMAND_SET_CALIBRATE) || 
+             (entry[0] == SX1268_COMMAND_SET_CALIBRATE_IMAGE) ||
+             (entry[0] == SX1268_COMMAND_SET_DIO3_AS_TCXO_CTRL)))                           /* long busy commands */
+        {
+            res = a_sx1268_batch_flush(handle);                                             /* flush and wait */
+        }
+        pos += 2 + entry[1];                                                                /* next entry */
+    }
+    if (res == 0)                                                                           /* check result */
+    {
+        res = a_sx1268_batch_flush(handle);                                                 /* flush and wait */
+    }
+    else
+    {
+        handle->batch_num = 0;                                                              /* drop the batch */
+        handle->batch_len = 0;                                                              /* drop the batch */
+    }
+    handle->batch = 0;                                                                      /* stop recording */
+    handle->batch_gap_us = gap;                                                             /* restore the gap */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: config replay failed.\n");                            /* config replay failed */
        
-        return 3;                                                                          /* return error */
+        return 1;                                                                           /* return error */
     }
-    if (handle->reset_gpio_write == NULL)                                                  /* check reset_gpio_write */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the register retention list
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *reg points to a register address list
+ * @param[in] num is the register number
+ * @return    status code
+ *            - 0 success
+ *            - 1 set retention list failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is over SX1268_RETENTION_LIST_MAX_NUM
+ * @note      the listed registers keep their values in the warm start sleep mode,
+ *            the list is lost after a reset or a cold start sleep
+ */
+uint8_t sx1268_set_retention_list(sx1268_handle_t *handle, uint16_t *reg, uint8_t num)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t buf[1 + 2 * SX1268_RETENTION_LIST_MAX_NUM];
+    
+    if (handle == NULL)                                                                     /* check handle */
     {
-        handle->debug_print("sx1268: reset_gpio_write is null.\n");                        /* reset_gpio_write is null */
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (num > SX1268_RETENTION_LIST_MAX_NUM)                                                /* check the number */
+    {
+        handle->debug_print("sx1268: num is over %d.\n", SX1268_RETENTION_LIST_MAX_NUM);   /* num is over max */
+        
+        return 5;                                                                           /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                      /* check busy */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                    /* chip is busy */
        
-        return 3;                                                                          /* return error */
+        return 4;                                                                           /* return error */
     }
-    if (handle->busy_gpio_init == NULL)                                                    /* check busy_gpio_init */
+    
+    buf[0] = num;                                                                           /* set the number */
+    for (i = 0; i < num; i++)                                                               /* set all registers */
     {
-        handle->debug_print("sx1268: busy_gpio_init is null.\n");                          /* busy_gpio_init is null */
+        buf[1 + 2 * i] = (reg[i] >> 8) & 0xFF;                                              /* set reg msb */
+        buf[2 + 2 * i] = (reg[i] >> 0) & 0xFF;                                              /* set reg lsb */
+    }
+    res = a_sx1268_spi_write_register(handle, SX1268_REG_RETENTION_LIST, 
+                                      (uint8_t *)buf, 1 + 2 * num);                         /* write register */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: write register failed.\n");                           /* write register failed */
        
-        return 3;                                                                          /* return error */
+        return 1;                                                                           /* return error */
     }
-    if (handle->busy_gpio_deinit == NULL)                                                  /* check busy_gpio_deinit */
+    for (i = 0; i < num; i++)                                                               /* save all registers */
     {
-        handle->debug_print("sx1268: busy_gpio_deinit is null.\n");                        /* busy_gpio_deinit is null */
+        handle->retention_reg[i] = reg[i];                                                  /* save the register */
+    }
+    handle->retention_num = num;                                                            /* save the number */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     wake up the chip and restore the lost registers
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      after a warm start only the cached registers which are not in the retention
+ *            list are written again, it needs the register cache
+ */
+uint8_t sx1268_wake_up(sx1268_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t value;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                      /* wake up and check busy */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                    /* chip is busy */
        
-        return 3;                                                                          /* return error */
+        return 4;                                                                           /* return error */
     }
-    if (handle->busy_gpio_read == NULL)                                                    /* check busy_gpio_read */
+    
+    for (i = 0; i < SX1268_REGISTER_CACHE_SIZE; i++)                                        /* check all registers */
+    {
+        if ((handle->reg_cache_lost & ((uint32_t)1 << i)) == 0)                             /* check the lost bit */
+        {
+            continue;                                                                       /* next */
+        }
+        res = a_sx1268_check_busy(handle);                                                  /* check busy */
+        if (res != 0)                                                                       /* check result */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                                /* chip is busy */
+           
+            return 4;                                                                       /* return error */
+        }
+        value = handle->reg_cache[i];                                                       /* get the saved value */
+        res = a_sx1268_spi_write_register(handle, gs_cache_reg[i], (uint8_t *)&value, 1);   /* write register */
+        if (res != 0)                                                                       /* check result */
+        {
+            handle->debug_print("sx1268: write register failed.\n");                       /* write register failed */
+           
+            return 1;                                                                       /* return error */
+        }
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the frequency hopping table
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *freq points to a channel frequency list in Hz
+ * @param[in] *table points to a hop channel table
+ * @param[in] num is the channel number
+ * @param[in] mode is the hop mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 get random number or calibrate image failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is 0
+ * @note      the set rf frequency payload of every channel is precomputed into table,
+ *            the table must stay valid while hopping, one image band spanning all
+ *            channels is calibrated here so hopping never runs calibrate image,
+ *            the random sequence is seeded by sx1268_get_random_number
+ */
+uint8_t sx1268_hop_init(sx1268_handle_t *handle, uint32_t *freq, sx1268_hop_channel_t *table,
+                        uint8_t num, sx1268_hop_mode_t mode)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t image[2];
+    uint32_t reg;
+    uint32_t seed;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (num == 0)                                                                        /* check the number */
+    {
+        handle->debug_print("sx1268: num is 0.\n");                                      /* num is 0 */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    image[0] = 0xFF;                                                                     /* init the lower bound */
+    image[1] = 0x00;                                                                     /* init the upper bound */
+    for (i = 0; i < num; i++)                                                            /* find the image band of the plan */
+    {
+        if ((freq[i] / 4000000U) < image[0])                                             /* 4 MHz step lower bound */
+        {
+            image[0] = (uint8_t)(freq[i] / 4000000U);                                    /* set the lower bound */
+        }
+        if (((freq[i] + 3999999U) / 4000000U) > image[1])                                /* 4 MHz step upper bound */
+        {
+            image[1] = (uint8_t)((freq[i] + 3999999U) / 4000000U);                       /* set the upper bound */
+        }
+    }
+    if (image[1] <= image[0])                                                            /* check the band */
+    {
+        image[1] = image[0] + 1;                                                         /* widen the band */
+    }
+    for (i = 0; i < num; i++)                                                            /* precompute all channels */
+    {
+        reg = (uint32_t)(((uint64_t)freq[i] << 25) / 32000000U);                         /* convert the frequency */
+        table[i].frequency[0] = (reg >> 24) & 0xFF;                                      /* bit 31 : 24 */
+        table[i].frequency[1] = (reg >> 16) & 0xFF;                                      /* bit 23 : 16 */
+        table[i].frequency[2] = (reg >> 8) & 0xFF;                                       /* bit 15 : 8 */
+        table[i].frequency[3] = (reg >> 0) & 0xFF;                                       /* bit 7 : 0 */
+        table[i].image[0] = image[0];                                                    /* one band for the whole plan */
+        table[i].image[1] = image[1];                                                    /* one band for the whole plan */
+        table[i].blacklist = 0;                                                          /* not blacklisted */
+    }
+    res = sx1268_get_random_number(handle, (uint32_t *)&seed);                           /* get the seed */
+    if (res != 0)                                                                        /* check result */
+    {
+        return res;                                                                      /* return error */
+    }
+    if ((image[0] != handle->hop_image[0]) || (image[1] != handle->hop_image[1]))        /* check the image band */
+    {
+        if (a_sx1268_check_busy(handle) != 0)                                            /* check busy */
+        {
+            handle->debug_print("sx1268: chip is busy.\n");                              /* chip is busy */
+            
+            return 4;                                                                    /* return error */
+        }
+        if (a_sx1268_spi_write(handle, SX1268_COMMAND_SET_CALIBRATE_IMAGE, 
+                               image, 2) != 0)                                           /* write command */
+        {
+            handle->debug_print("sx1268: calibrate image failed.\n");                    /* calibrate image failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        handle->hop_image[0] = image[0];                                                 /* save the image band */
+        handle->hop_image[1] = image[1];                                                 /* save the image band */
+    }
+    
+    handle->hop_table = table;                                                           /* set the table */
+    handle->hop_num = num;                                                               /* set the number */
+    handle->hop_channel = num - 1;                                                       /* the first hop goes to channel 0 */
+    handle->hop_mode = (uint8_t)mode;                                                    /* set the mode */
+    handle->hop_seed = (seed != 0) ? seed : 0x2545F491U;                                 /* xorshift seed must not be 0 */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable a hop channel
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] channel is the channel index
+ * @param[in] enable is a bool value, SX1268_BOOL_TRUE blacklists the channel
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 channel is invalid
+ * @note      none
+ */
+uint8_t sx1268_hop_set_blacklist(sx1268_handle_t *handle, uint8_t channel, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if ((handle->hop_table == NULL) || (channel >= handle->hop_num))      /* check the channel */
+    {
+        handle->debug_print("sx1268: channel is invalid.\n");             /* channel is invalid */
+        
+        return 5;                                                         /* return error */
+    }
+    
+    handle->hop_table[channel].blacklist = (uint8_t)enable;               /* set the blacklist */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable hopping on completion
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 hop table is not initialized
+ * @note      when enabled, sx1268_irq_handler retunes to the next channel on tx done,
+ *            single rx done and timeout after it runs the callbacks and before the
+ *            next queued frame is sent, a callback which starts tx, rx or cad keeps
+ *            the current channel and the hop happens on the next completion
+ */
+uint8_t sx1268_hop_set_enable(sx1268_handle_t *handle, sx1268_bool_t enable)
+{
+    if (handle == NULL)                                                   /* check handle */
+    {
+        return 2;                                                         /* return error */
+    }
+    if (handle->inited != 1)                                              /* check handle initialization */
+    {
+        return 3;                                                         /* return error */
+    }
+    if ((enable != SX1268_BOOL_FALSE) && (handle->hop_table == NULL))     /* check the table */
+    {
+        handle->debug_print("sx1268: hop table is not initialized.\n");   /* hop table is not initialized */
+        
+        return 5;                                                         /* return error */
+    }
+    
+    handle->hop_enable = (uint8_t)enable;                                 /* set the hop */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief      hop to the next channel
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *channel points to a channel index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 hop failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 no channel is available
+ * @note       the chip must be in the standby or fs mode
+ */
+uint8_t sx1268_hop_next(sx1268_handle_t *handle, uint8_t *channel)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                   /* check handle */
     {
-        handle->debug_print("sx1268: busy_gpio_read is null.\n");                          /* busy_gpio_read is null */
-       
-        return 3;                                                                          /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->delay_ms == NULL)                                                          /* check delay_ms */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        handle->debug_print("sx1268: delay_ms is null.\n");                                /* delay_ms is null */
-       
-        return 3;                                                                          /* return error */
+        return 3;                                                         /* return error */
     }
-    if (handle->receive_callback == NULL)                                                  /* check receive_callback */
+    if (handle->hop_table == NULL)                                        /* check the table */
     {
-        handle->debug_print("sx1268: receive_callback is null.\n");                        /* receive_callback is null */
-       
-        return 3;                                                                          /* return error */
+        handle->debug_print("sx1268: hop table is not initialized.\n");   /* hop table is not initialized */
+        
+        return 5;                                                         /* return error */
     }
     
-    if (handle->spi_init() != 0)                                                           /* spi initialization */
+    res = a_sx1268_hop_next(handle);                                      /* retune */
+    if (res == 4)                                                         /* check result */
     {
-        handle->debug_print("sx1268: spi initialization failed.\n");                       /* spi initialization failed */
-       
-        return 1;                                                                          /* return error */ 
+        handle->debug_print("sx1268: chip is busy.\n");                  /* chip is busy */
+        
+        return 4;                                                         /* return error */
     }
-    if (handle->reset_gpio_init() != 0)                                                    /* reset gpio initialization */
+    else if (res == 5)                                                    /* check result */
     {
-        handle->debug_print("sx1268: reset gpio initialization failed.\n");                /* reset gpio initialization failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
+        handle->debug_print("sx1268: no channel is available.\n");       /* no channel is available */
         
-        return 4;                                                                          /* return error */ 
+        return 5;                                                         /* return error */
     }
-    if (handle->busy_gpio_init() != 0)                                                     /* busy gpio initialization */
+    else if (res != 0)                                                    /* check result */
     {
-        handle->debug_print("sx1268: busy gpio initialization failed.\n");                 /* busy gpio initialization failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
+        handle->debug_print("sx1268: hop failed.\n");                    /* hop failed */
         
-        return 5;                                                                          /* return error */ 
+        return 1;                                                         /* return error */
     }
+    *channel = handle->hop_channel;                                       /* get the channel */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief     stage the next lora frame in the idle half of the data buffer
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 stage failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 len is over SX1268_TX_PIPELINE_HALF_SIZE
+ *            - 6 a frame is already staged
+ * @note      it can be called while the previous frame is on air
+ */
+uint8_t sx1268_lora_tx_stage(sx1268_handle_t *handle, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
     
-    if (handle->reset_gpio_write(1) != 0)                                                  /* set high */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        handle->debug_print("sx1268: reset chip failed.\n");                               /* reset chip failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
-        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
-        
-        return 6;                                                                          /* return error */ 
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
     }
-    handle->delay_ms(5);                                                                   /* delay 5 ms */
-    if (handle->reset_gpio_write(0) != 0)                                                  /* set low */
+    if (len > SX1268_TX_PIPELINE_HALF_SIZE)                                                   /* check the length */
     {
-        handle->debug_print("sx1268: reset chip failed.\n");                               /* reset chip failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
-        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
+        handle->debug_print("sx1268: len is over %d.\n", SX1268_TX_PIPELINE_HALF_SIZE);      /* len is over half size */
         
-        return 6;                                                                          /* return error */ 
+        return 5;                                                                             /* return error */
     }
-    handle->delay_ms(10);                                                                  /* delay 5 ms */
-    if (handle->reset_gpio_write(1) != 0)                                                  /* set high */
+    if (handle->tx_pipe_staged != 0)                                                          /* check the staged frame */
     {
-        handle->debug_print("sx1268: reset chip failed.\n");                               /* reset chip failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
-        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
+        handle->debug_print("sx1268: a frame is already staged.\n");                         /* a frame is already staged */
         
-        return 6;                                                                          /* return error */ 
+        return 6;                                                                             /* return error */
     }
-    handle->delay_ms(5);                                                                   /* delay 5 ms */
     
-    if (a_sx1268_spi_read(handle, SX1268_COMMAND_GET_STATUS, (uint8_t *)buf, 2) != 0)      /* read command */
+    res = a_sx1268_check_busy(handle);                                                        /* check busy */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("sx1268: get status failed.\n");                               /* get status failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
-        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
-        
-        return 6;                                                                          /* return error */
+        handle->debug_print("sx1268: chip is busy.\n");                                      /* chip is busy */
+       
+        return 4;                                                                             /* return error */
     }
-    prev = 0x00;
-    if (a_sx1268_spi_write(handle, SX1268_COMMAND_SET_STANDBY, (uint8_t *)&prev, 1) != 0)  /* write command */
+    
+    res = a_sx1268_spi_write_buffer(handle, 
+                                    (uint8_t)(handle->tx_pipe_next * SX1268_TX_PIPELINE_HALF_SIZE), 
+                                    buf, len);                                                /* write buffer */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("sx1268: set standby failed.\n");                              /* set standby failed */
-        (void)handle->spi_deinit();                                                        /* spi deinit */
-        (void)handle->reset_gpio_deinit();                                                 /* reset gpio deinit */
-        (void)handle->busy_gpio_deinit();                                                  /* busy gpio deinit */
-        
-        return 6;                                                                          /* return error */
+        handle->debug_print("sx1268: write buffer failed.\n");                               /* write buffer failed */
+       
+        return 1;                                                                             /* return error */
     }
-    handle->inited = 1;                                                                    /* flag finish initialization */
+    handle->tx_pipe_len = (uint8_t)len;                                                       /* save the length */
+    handle->tx_pipe_staged = 1;                                                               /* flag staged */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     start sending the staged lora frame
  * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] us is the timeout
  * @return    status code
  *            - 0 success
- *            - 1 spi deinit failed
+ *            - 1 send failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 chip is busy
- *            - 5 power down failed
- *            - 6 busy gpio deinit failed
- *            - 7 reset gpio deinit failed
- * @note      none
+ *            - 5 no frame is staged
+ *            - 6 tx is running
+ * @note      it returns as soon as the chip is in tx, tx done is reported by sx1268_irq_handler,
+ *            with the register cache and the config diff only clear irq status, set buffer base address,
+ *            set packet params and set tx are sent, the blocking transmit functions write their
+ *            payload at the tx base address left by the pipeline
  */
-uint8_t sx1268_deinit(sx1268_handle_t *handle)
+uint8_t sx1268_lora_tx_pipeline(sx1268_handle_t *handle, uint16_t preamble_length, sx1268_lora_header_t header_type,
+                                sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable, uint32_t us)
 {
-    uint8_t res, prev;
+    uint8_t res;
+    uint8_t setup;
+    uint8_t buffer[6];
+    uint32_t reg;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                                    /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                               /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                                          /* return error */
+    }
+    if (handle->tx_pipe_staged == 0)                                                                       /* check the staged frame */
+    {
+        handle->debug_print("sx1268: no frame is staged.\n");                                             /* no frame is staged */
+        
+        return 5;                                                                                          /* return error */
+    }
+    if (handle->state == SX1268_CHIP_STATE_TX)                                                             /* check the state */
+    {
+        handle->debug_print("sx1268: tx is running.\n");                                                  /* tx is running */
+        
+        return 6;                                                                                          /* return error */
     }
     
-    res = a_sx1268_check_busy(handle);                                                     /* check busy */
-    if (res != 0)                                                                          /* check result */
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                    /* chip is busy */
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
        
-        return 4;                                                                          /* return error */
+        return 4;                                                                                          /* return error */
+    }
+    buffer[0] = 0x03;                                                                                      /* clear all irqs */
+    buffer[1] = 0xFF;                                                                                      /* clear all irqs */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buffer, 2);               /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: clear irq status failed.\n");                                        /* clear irq status failed */
+       
+        return 1;                                                                                          /* return error */
     }
     
-    prev = 0x00;                                                                           /* set power down */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_SLEEP, (uint8_t *)&prev, 1);       /* write command */
-    if (res != 0)                                                                          /* check result */
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
     {
-        handle->debug_print("sx1268: power down failed.\n");                               /* power down failed */
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
        
-        return 5;                                                                          /* return error */
+        return 4;                                                                                          /* return error */
+    }
+    res = a_sx1268_spi_read_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);          /* read register */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: read register failed.\n");                                           /* read register failed */
+       
+        return 1;                                                                                          /* return error */
+    }
+    if (invert_iq_enable == SX1268_BOOL_FALSE)                                                             /* not invert iq */
+    {
+        setup |= (1 << 2);                                                                                 /* set bit 2 */
+    }
+    else
+    {
+        setup &= ~(1 << 2);                                                                                /* clear bit 2 */
+    }
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    res = a_sx1268_spi_write_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);         /* write register */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: write register failed.\n");                                          /* write register failed */
+       
+        return 1;                                                                                          /* return error */
     }
     
-    res = handle->busy_gpio_deinit();                                                      /* busy gpio deinit */
-    if (res != 0)                                                                          /* check result */
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
     {
-        handle->debug_print("sx1268: busy gpio deinit failed.\n");                         /* busy gpio deinit failed */
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
        
-        return 6;                                                                          /* return error */
+        return 4;                                                                                          /* return error */
     }
-    res = handle->reset_gpio_deinit();                                                     /* reset gpio deinit */
-    if (res != 0)                                                                          /* check result */
+    buffer[0] = (uint8_t)(handle->tx_pipe_next * SX1268_TX_PIPELINE_HALF_SIZE);                            /* tx base address */
+    buffer[1] = handle->rx_base;                                                                           /* keep the rx base address */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_BUFFER_BASE_ADDRESS, (uint8_t *)buffer, 2);        /* write command */
+    if (res != 0)                                                                                          /* check result */
     {
-        handle->debug_print("sx1268: reset gpio deinit failed.\n");                        /* reset gpio deinit failed */
+        handle->debug_print("sx1268: set buffer base address failed.\n");                                 /* set buffer base address failed */
        
-        return 7;                                                                          /* return error */
+        return 1;                                                                                          /* return error */
     }
-    res = handle->spi_deinit();                                                            /* spi deinit */
-    if (res != 0)                                                                          /* check result */
+    
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
     {
-        handle->debug_print("sx1268: spi deinit failed.\n");                               /* spi deinit failed */
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
        
-        return 1;                                                                          /* return error */
+        return 4;                                                                                          /* return error */
+    }
+    buffer[0] = (preamble_length >> 8) & 0xFF;                                                             /* set param */
+    buffer[1] = (preamble_length >> 0) & 0xFF;                                                             /* set param */
+    buffer[2] = header_type;                                                                               /* set param */
+    buffer[3] = handle->tx_pipe_len;                                                                       /* set param */
+    buffer[4] = crc_type;                                                                                  /* set param */
+    buffer[5] = invert_iq_enable;                                                                          /* set param */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_PACKET_PARAMS, (uint8_t *)buffer, 6);              /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: set lora packet params failed.\n");                                  /* set lora packet params failed */
+       
+        return 1;                                                                                          /* return error */
     }
     
-    return 0;                                                                              /* success return 0 */
+    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                                   /* chip is busy */
+       
+        return 4;                                                                                          /* return error */
+    }
+    reg = (uint32_t)(((uint64_t)us * 8) / 125);                                                           /* convert the timeout */
+    buffer[0] = (reg >> 16) & 0xFF;                                                                        /* bit 23 : 16 */
+    buffer[1] = (reg >> 8) & 0xFF;                                                                         /* bit 15 : 8 */
+    buffer[2] = (reg >> 0) & 0xFF;                                                                         /* bit 7 : 0 */
+    handle->tx_done = 0;                                                                                   /* flag 0 */
+    handle->timeout = 0;                                                                                   /* flag 0 */
+    handle->operation = SX1268_OPERATION_TX;                                                               /* set operation */
+    handle->operation_status = SX1268_OPERATION_STATUS_RUNNING;                                            /* wait for the irq */
+    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_TX, (uint8_t *)buffer, 3);                         /* write command */
+    if (res != 0)                                                                                          /* check result */
+    {
+        handle->debug_print("sx1268: set tx failed.\n");                                                  /* set tx failed */
+        handle->operation_status = SX1268_OPERATION_STATUS_IDLE;                                           /* not started */
+       
+        return 1;                                                                                          /* return error */
+    }
+    handle->tx_pipe_next ^= 1;                                                                             /* stage into the other half */
+    handle->tx_pipe_staged = 0;                                                                            /* the frame is on air */
+    
+    return 0;                                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enter to the single receive mode
+ * @brief     init the priority tx queue
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] us is the rx timeout
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] us is the tx timeout of every queued frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it drops all queued frames and must not run concurrently with sx1268_tx_queue_push
+ */
+uint8_t sx1268_tx_queue_init(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                             uint16_t preamble_length, sx1268_lora_header_t header_type,
+                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable, uint32_t us)
+{
+    uint8_t i;
+    uint8_t j;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    for (i = 0; i < SX1268_TX_QUEUE_PRIORITY_NUM; i++)                         /* all priorities */
+    {
+        handle->tx_queue[i].head = 0;                                          /* reset head */
+        handle->tx_queue[i].tail = 0;                                          /* reset tail */
+        for (j = 0; j < SX1268_TX_QUEUE_DEPTH; j++)                            /* all slots */
+        {
+            handle->tx_queue[i].slot[j].seq = j;                               /* slot is free */
+        }
+    }
+    handle->tx_queue_standby = (uint8_t)standby_src;                           /* save standby source */
+    handle->tx_queue_preamble = preamble_length;                               /* save preamble length */
+    handle->tx_queue_header = (uint8_t)header_type;                            /* save header type */
+    handle->tx_queue_crc = (uint8_t)crc_type;                                  /* save crc type */
+    handle->tx_queue_iq = (uint8_t)invert_iq_enable;                           /* save invert iq */
+    handle->tx_queue_timeout_us = us;                                          /* save timeout */
+    handle->tx_queue_active = 0;                                               /* nothing on air */
+    handle->tx_queue_retry = 0;                                                /* no frame to resend */
+    SX1268_TX_QUEUE_BARRIER();                                                 /* publish the queue */
+    handle->tx_queue_enable = 1;                                               /* enable */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     push a frame into the priority tx queue
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] priority is the frame priority
+ * @param[in] *buf points to a frame buffer
+ * @param[in] len is the frame length
  * @return    status code
  *            - 0 success
- *            - 1 lora single receive failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- * @note      none
+ *            - 5 tx queue is not initialized
+ *            - 6 priority or len is invalid
+ *            - 7 tx queue is full
+ * @note      it is lock free and can be called from several threads at the same time,
+ *            the buffer is not copied and must stay valid until its tx done or timeout callback,
+ *            len must not be over 256 - tx base address
  */
-uint8_t sx1268_single_receive(sx1268_handle_t *handle, double us)
+uint8_t sx1268_tx_queue_push(sx1268_handle_t *handle, sx1268_tx_priority_t priority, uint8_t *buf, uint16_t len)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    uint16_t clear_irq_param;
-    uint32_t timeout;
+    sx1268_tx_queue_t *q;
+    sx1268_tx_slot_t *slot;
+    uint32_t pos;
+    int32_t diff;
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
-    {
-        return 3;                                                                               /* return error */
+        return 2;                                                              /* return error */
     }
-
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
+        return 3;                                                              /* return error */
     }
-    
-    clear_irq_param = 0x03FF;                                                                   /* set mask */
-    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
-    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
-    if (res != 0)                                                                               /* check result */
+    if (handle->tx_queue_enable == 0)                                          /* check tx queue */
     {
-        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
-       
-        return 1;                                                                               /* return error */
+        handle->debug_print("sx1268: tx queue is not initialized.\n");         /* tx queue is not initialized */
+        
+        return 5;                                                              /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
+    if (((uint32_t)priority >= SX1268_TX_QUEUE_PRIORITY_NUM) || (len > 255) || 
+        (len > 256 - (uint16_t)handle->tx_base))                               /* check param */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
+        handle->debug_print("sx1268: priority or len is invalid.\n");          /* priority or len is invalid */
+        
+        return 6;                                                              /* return error */
     }
     
-    timeout = (uint32_t)(us / 15.625);                                                          /* convert real data to register data */
-    buf[0] = (timeout >> 16) & 0xFF;                                                            /* bit 23 : 16 */
-    buf[1] = (timeout >> 8) & 0xFF;                                                             /* bit 15 : 8 */
-    buf[2] = (timeout >> 0) & 0xFF;                                                             /* bit 7 : 0 */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_RX, (uint8_t *)buf, 3);                 /* write command */
-    if (res != 0)                                                                               /* check result */
+    q = &handle->tx_queue[priority];                                           /* get queue */
+    pos = q->tail;                                                             /* get tail */
+    while (1)                                                                  /* loop */
     {
-        handle->debug_print("sx1268: set rx failed.\n");                                        /* set rx failed */
-       
-        return 1;                                                                               /* return error */
+        slot = &q->slot[pos & (SX1268_TX_QUEUE_DEPTH - 1)];                    /* get slot */
+        diff = (int32_t)(slot->seq - pos);                                     /* slot state */
+        if (diff == 0)                                                         /* free slot */
+        {
+            if (SX1268_TX_QUEUE_CAS(&q->tail, pos, pos + 1))                   /* claim it */
+            {
+                break;                                                         /* break */
+            }
+        }
+        else if (diff < 0)                                                     /* not consumed yet */
+        {
+            handle->debug_print("sx1268: tx queue is full.\n");                /* tx queue is full */
+            
+            return 7;                                                          /* return error */
+        }
+        pos = q->tail;                                                         /* reload tail */
     }
+    slot->buf = buf;                                                           /* set buffer */
+    slot->len = len;                                                           /* set length */
+    SX1268_TX_QUEUE_BARRIER();                                                 /* write the slot before seq */
+    slot->seq = pos + 1;                                                       /* publish */
     
-    return 0;                                                                                   /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     enter to the continuous receive mode
+ * @brief     start sending the queued frames
  * @param[in] *handle points to a sx1268 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 lora continuous receive failed
+ *            - 1 send failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 chip is busy
- * @note      none
+ *            - 5 tx queue is not initialized
+ *            - 6 len is over the tx buffer
+ * @note      it does nothing if a queued frame is on air or the queue is empty, the following
+ *            frames are sent back to back by sx1268_irq_handler, it can be called from any
+ *            thread after sx1268_tx_queue_push, a compare and swap on the dispatcher flag lets
+ *            only one caller send at a time, the spi and busy links must be serialized by the
+ *            port if sx1268_irq_handler runs in another thread, a frame which fails to start
+ *            returns 1 and stays at the head of the queue until the next call, a frame over the
+ *            tx buffer returns 6 and stays at the head until the tx base address is lowered
  */
-uint8_t sx1268_continuous_receive(sx1268_handle_t *handle)
+uint8_t sx1268_tx_queue_start(sx1268_handle_t *handle)
 {
     uint8_t res;
-    uint16_t clear_irq_param;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                               /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                               /* return error */
+        return 3;                                                              /* return error */
     }
-
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
+    if (handle->tx_queue_enable == 0)                                          /* check tx queue */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
+        handle->debug_print("sx1268: tx queue is not initialized.\n");         /* tx queue is not initialized */
+        
+        return 5;                                                              /* return error */
     }
-    
-    clear_irq_param = 0x03FF;                                                                   /* set mask */
-    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
-    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
-    if (res != 0)                                                                               /* check result */
+    if (SX1268_TX_QUEUE_CAS(&handle->tx_queue_active, 0, 1) == 0)             /* claim the dispatcher */
     {
-        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
-       
-        return 1;                                                                               /* return error */
+        return 0;                                                              /* irq handler sends the rest */
     }
     
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
+    res = a_sx1268_tx_queue_dispatch(handle);                                  /* send the next frame */
+    if (res == 5)                                                              /* check result */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
+        return 6;                                                              /* return error */
     }
     
-    buf[0] = 0xFF;                                                                              /* bit 23 : 16 */
-    buf[1] = 0xFF;                                                                              /* bit 15 : 8 */
-    buf[2] = 0xFF;                                                                              /* bit 7 : 0 */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_RX, (uint8_t *)buf, 3);                 /* write command */
-    if (res != 0)                                                                               /* check result */
+    return res;                                                                /* return the result */
+}
+
+/**
+ * @brief     set the rx ring
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a ring buffer of depth * slot_size bytes, NULL disables the ring
+ * @param[in] slot_size is the slot size including the 2 bytes length
+ * @param[in] depth is the slot number
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 slot size or depth is invalid
+ * @note      with the ring sx1268_irq_handler stores every valid packet into the ring and
+ *            runs the rx done callback with a NULL buffer, call it while the chip is not in rx
+ */
+uint8_t sx1268_set_rx_ring(sx1268_handle_t *handle, uint8_t *buf, uint16_t slot_size, uint8_t depth)
+{
+    if (handle == NULL)                                                                   /* check handle */
     {
-        handle->debug_print("sx1268: set rx failed.\n");                                        /* set rx failed */
-       
-        return 1;                                                                               /* return error */
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if ((buf != NULL) && ((slot_size <= SX1268_RX_RING_HEADER_SIZE) || (depth == 0)))     /* check param */
+    {
+        handle->debug_print("sx1268: slot size or depth is invalid.\n");                  /* slot size or depth is invalid */
+        
+        return 5;                                                                         /* return error */
     }
     
-    return 0;                                                                                   /* success return 0 */
+    handle->rx_ring_buf = NULL;                                                           /* stop the producer */
+    SX1268_RX_RING_BARRIER();                                                             /* before changing the ring */
+    handle->rx_ring_slot_size = slot_size;                                                /* set slot size */
+    handle->rx_ring_depth = depth;                                                        /* set depth */
+    handle->rx_ring_head = 0;                                                             /* reset head */
+    handle->rx_ring_tail = 0;                                                             /* reset tail */
+    handle->rx_ring_overflow = 0;                                                         /* reset overflow */
+    SX1268_RX_RING_BARRIER();                                                             /* publish the ring */
+    handle->rx_ring_buf = buf;                                                            /* set buffer */
+    
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      run the cad
+ * @brief      read several packets from the rx ring
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[out] *enable points to a enable buffer
+ * @param[out] *buf points to num buffers of size bytes each
+ * @param[in]  size is the size of each buffer
+ * @param[out] *len points to num length buffers
+ * @param[in]  num is the max packet number
+ * @param[out] *count points to a read packet number buffer
  * @return     status code
  *             - 0 success
- *             - 1 lora cad failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
- *             - 5 cad timeout
- * @note       none
+ *             - 5 rx ring is not set
+ * @note       only one reader is allowed, packets longer than size are cut
  */
-uint8_t sx1268_lora_cad(sx1268_handle_t *handle, sx1268_bool_t *enable)
+uint8_t sx1268_receive_batch(sx1268_handle_t *handle, uint8_t *buf, uint16_t size,
+                             uint16_t *len, uint8_t num, uint8_t *count)
 {
-    uint8_t res;
-    uint16_t clear_irq_param;
-    uint8_t buf[2];
-    uint16_t timeout;
-    
-    if (handle == NULL)                                                                         /* check handle */
-    {
-        return 2;                                                                               /* return error */
-    }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
-    {
-        return 3;                                                                               /* return error */
-    }
-
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
-    {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
-    }
+    uint8_t i;
+    uint8_t *slot;
+    uint16_t l;
+    uint32_t head;
+    uint32_t tail;
     
-    clear_irq_param = 0x03FF;                                                                   /* set mask */
-    buf[0] = (clear_irq_param >> 8) & 0xFF;                                                     /* set param */
-    buf[1] = (clear_irq_param >> 0) & 0xFF;                                                     /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buf, 2);       /* write command */
-    if (res != 0)                                                                               /* check result */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        handle->debug_print("sx1268: clear irq status failed.\n");                              /* clear irq status failed */
-       
-        return 1;                                                                               /* return error */
+        return 2;                                                                         /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                                                          /* check busy */
-    if (res != 0)                                                                               /* check result */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
-       
-        return 4;                                                                               /* return error */
+        return 3;                                                                         /* return error */
     }
-    
-    handle->cad_done = 0;                                                                       /* clear cad done */
-    handle->cad_detected = 0;                                                                   /* clear cad done */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_CAD, NULL, 0);                          /* write command */
-    if (res != 0)                                                                               /* check result */
+    if (handle->rx_ring_buf == NULL)                                                      /* check rx ring */
     {
-        handle->debug_print("sx1268: set cad failed.\n");                                       /* set cad failed */
-       
-        return 1;                                                                               /* return error */
+        handle->debug_print("sx1268: rx ring is not set.\n");                             /* rx ring is not set */
+        
+        return 5;                                                                         /* return error */
     }
     
-    timeout = 10000;                                                                            /*  set timeout */
-    while ((timeout != 0) && (handle->cad_done == 0))                                           /* wait */
+    head = handle->rx_ring_head;                                                          /* get head */
+    tail = handle->rx_ring_tail;                                                          /* get tail once */
+    SX1268_RX_RING_BARRIER();                                                             /* read the slots after tail */
+    for (i = 0; (i < num) && (head != tail); i++)                                         /* drain up to num */
     {
-        handle->delay_ms(1);                                                                    /* delay 1 ms */
-        timeout--;                                                                              /* timeout-- */
-    }
-    if (timeout == 0)                                                                           /* check timeout */
-    {
-        handle->debug_print("sx1268: cad timeout.\n");                                          /* cad timeout */
-       
-        return 5;                                                                               /* return error */
-    }
-    if (handle->cad_detected == 1)                                                              /* set cad */
-    {
-        *enable = SX1268_BOOL_TRUE;                                                             /* enable */
-    }
-    else
-    {
-        *enable = SX1268_BOOL_FALSE;                                                            /* disable */
+        slot = &handle->rx_ring_buf[(head % handle->rx_ring_depth) * 
+                                    handle->rx_ring_slot_size];                           /* get slot */
+        l = (uint16_t)slot[0] | ((uint16_t)slot[1] << 8);                                 /* get length */
+        if (l > size)                                                                     /* check size */
+        {
+            l = size;                                                                     /* cut */
+        }
+        memcpy(&buf[(uint32_t)i * size], &slot[SX1268_RX_RING_HEADER_SIZE], l);           /* copy payload */
+        len[i] = l;                                                                       /* set length */
+        head++;                                                                           /* next slot */
     }
+    SX1268_RX_RING_BARRIER();                                                             /* copy before releasing */
+    handle->rx_ring_head = head;                                                          /* release the slots */
+    *count = i;                                                                           /* set count */
     
-    return 0;                                                                                   /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      check the packet error
+ * @brief      get the rx ring overflow counter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[out] *enable points to a bool buffer
+ * @param[out] *count points to a counter buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       packets dropped because the ring is full or the slot is too small
  */
-uint8_t sx1268_check_packet_error(sx1268_handle_t *handle, sx1268_bool_t *enable)
+uint8_t sx1268_get_rx_ring_overflow(sx1268_handle_t *handle, uint32_t *count)
 {
     if (handle == NULL)                                  /* check handle */
     {
@@ -1054,415 +5536,373 @@ uint8_t sx1268_check_packet_error(sx1268_handle_t *handle, sx1268_bool_t *enable
         return 3;                                        /* return error */
     }
     
-    *enable = (sx1268_bool_t)(handle->crc_error);        /* check error */
+    *count = handle->rx_ring_overflow;                   /* get counter */
     
     return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief     sent the lora data
+ * @brief     enable or disable the irq fast path
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] standby_src is the clock source
- * @param[in] preamble_length is the preamble length
- * @param[in] header_type is the header type
- * @param[in] crc_type is the crc type
- * @param[in] invert_iq_enable is a bool value
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
- * @param[in] us is the timeout
+ * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 sent failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- *            - 5 sent timeout
- *            - 6 irq timeout
- *            - 7 unknown result
- * @note      none
+ * @note      with the fast path and the spi_writev link clear irq status, get rx buffer status and
+ *            get packet status (rx_packet_callback only) share one bus transfer, busy is polled
+ *            before it and the port waits SX1268_IRQ_FAST_PATH_GAP_US with the chip select high
+ *            between the commands instead of polling busy, a port that can not keep the gap after
+ *            the chip select rises must not link spi_writev, then the fast path stays off,
+ *            the payload read is always a separate transfer,
+ *            worst case bus transfers per irq without hop and tx queue:
+ *            get irq status 1, clear irq status with both status reads 1, timeout workaround 3
+ *            (every timeout as the errata requires), read buffer 1, the normal path needs one more
+ *            transfer on rx done and another one with rx_packet_callback
  */
-uint8_t sx1268_lora_transmit(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
-                             uint16_t preamble_length, sx1268_lora_header_t header_type,
-                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
-                             uint8_t *buf, uint16_t len, uint32_t us)
+uint8_t sx1268_set_irq_fast_path(sx1268_handle_t *handle, sx1268_bool_t enable)
 {
-    uint8_t res;
-    uint8_t prev;
-    uint8_t buffer[6];
-    uint16_t clear_irq_param;
-    uint32_t ms;
-    uint32_t reg;
-    
-    if (handle == NULL)                                                                                    /* check handle */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                                                                                          /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                                                                               /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                                                                                          /* return error */
+        return 3;                                        /* return error */
     }
     
-    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
-    if (res != 0)                                                                                          /* check result */
+    handle->irq_fast = (uint8_t)enable;                  /* set fast path */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the irq fast path status
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_irq_fast_path(sx1268_handle_t *handle, sx1268_bool_t *enable)
+{
+    if (handle == NULL)                                  /* check handle */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
-       
-        return 4;                                                                                          /* return error */
+        return 2;                                        /* return error */
     }
-    
-    clear_irq_param = 0x03FF;                                                                              /* set mask */
-    buffer[0] = (clear_irq_param >> 8) & 0xFF;                                                             /* set param */
-    buffer[1] = (clear_irq_param >> 0) & 0xFF;                                                             /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_CLEAR_IRQ_STATUS, (uint8_t *)buffer, 2);               /* write command */
-    if (res != 0)                                                                                          /* check result */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        handle->debug_print("sx1268: clear irq status failed.\n");                                         /* clear irq status failed */
-       
-        return 1;                                                                                          /* return error */
+        return 3;                                        /* return error */
     }
     
-    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
-    if (res != 0)                                                                                          /* check result */
+    *enable = (sx1268_bool_t)(handle->irq_fast);         /* get fast path */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     register a handler for one irq type
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] irq is the irq type
+ * @param[in] *handler points to a handler function, NULL unregisters it
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 irq is invalid
+ * @note      once a handler or the status callback is registered the receive callback is no longer
+ *            called from sx1268_irq_handler and irq types without a handler are skipped
+ */
+uint8_t sx1268_set_irq_handler(sx1268_handle_t *handle, sx1268_irq_t irq, void (*handler)(uint8_t *buf, uint16_t len))
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
-       
-        return 4;                                                                                          /* return error */
+        return 2;                                                                              /* return error */
     }
-    
-    prev = standby_src;                                                                                    /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_STANDBY, (uint8_t *)&prev, 1);                     /* write command */
-    if (res != 0)                                                                                          /* check result */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->debug_print("sx1268: set standby failed.\n");                                              /* set standby failed */
-       
-        return 1;                                                                                          /* return error */
+        return 3;                                                                              /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
-    if (res != 0)                                                                                          /* check result */
+    if ((irq == 0) || ((irq & (irq - 1)) != 0) || (irq >= (1 << SX1268_IRQ_HANDLER_NUM)))      /* check irq */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
-       
-        return 4;                                                                                          /* return error */
+        handle->debug_print("sx1268: irq is invalid.\n");                                      /* irq is invalid */
+        
+        return 5;                                                                              /* return error */
     }
     
-    buffer[0] = (preamble_length >> 8) & 0xFF;                                                             /* set param */
-    buffer[1] = (preamble_length >> 0) & 0xFF;                                                             /* set param */
-    buffer[2] = header_type;                                                                               /* set param */
-    buffer[3] = (uint8_t)len;                                                                              /* set param */
-    buffer[4] = crc_type;                                                                                  /* set param */
-    buffer[5] = invert_iq_enable;                                                                          /* set param */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_PACKET_PARAMS, (uint8_t *)buffer, 6);              /* write command */
-    if (res != 0)                                                                                          /* check result */
+    i = 0;                                                                                     /* from bit 0 */
+    while (((uint16_t)irq >> i) != 1)                                                          /* find the bit */
     {
-        handle->debug_print("sx1268: set lora modulation params failed.\n");                               /* set lora modulation params failed */
-       
-        return 1;                                                                                          /* return error */
+        i++;                                                                                   /* next bit */
     }
-    
-    if (invert_iq_enable == SX1268_BOOL_FALSE)                                                             /* not invert iq */
+    handle->irq_handler[i] = handler;                                                          /* set handler */
+    if (handler != NULL)                                                                       /* register */
     {
-        uint8_t setup;
-        
-        res = a_sx1268_check_busy(handle);                                                                 /* check busy */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: chip is busy.\n");                                                /* chip is busy */
-           
-            return 4;                                                                                      /* return error */
-        }
-        
-        res = a_sx1268_spi_read_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);      /* read register */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
-           
-            return 1;                                                                                      /* return error */
-        }
-        
-        setup |= (1 << 2);                                                                                 /* set bit 2 */
-        res = a_sx1268_spi_write_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);     /* read register */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
-           
-            return 1;                                                                                      /* return error */
-        }
+        handle->irq_handler_mask |= (uint16_t)irq;                                             /* set the bit */
     }
     else
     {
-        uint8_t setup;
-        
-        res = a_sx1268_check_busy(handle);                                                                 /* check busy */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: chip is busy.\n");                                                /* chip is busy */
-           
-            return 4;                                                                                      /* return error */
-        }
-        
-        res = a_sx1268_spi_read_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);      /* read register */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
-           
-            return 1;                                                                                      /* return error */
-        }
-        
-        setup &= ~(1 << 2);                                                                                /* clear bit 2 */
-        res = a_sx1268_spi_write_register(handle, SX1268_REG_IQ_POLARITY_SETUP, (uint8_t *)&setup, 1);     /* read register */
-        if (res != 0)                                                                                      /* check result */
-        {
-            handle->debug_print("sx1268: read register failed.\n");                                        /* read register failed */
-           
-            return 1;                                                                                      /* return error */
-        }
+        handle->irq_handler_mask &= ~(uint16_t)irq;                                            /* clear the bit */
     }
+    handle->irq_table = ((handle->irq_handler_mask != 0) || 
+                         (handle->irq_status_callback != NULL)) ? 1 : 0;                       /* set table mode */
     
-    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
-    if (res != 0)                                                                                          /* check result */
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     register the irq status word callback
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *callback points to a callback function, NULL unregisters it
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it is called once per irq with the full irq status after the irq handlers
+ */
+uint8_t sx1268_set_irq_status_callback(sx1268_handle_t *handle, void (*callback)(uint16_t status))
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
-       
-        return 4;                                                                                          /* return error */
+        return 2;                                                                              /* return error */
     }
-    
-    if (a_sx1268_spi_write_buffer(handle, 0x00, buf, len) != 0)                                            /* write buffer */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->debug_print("sx1268: write buffer failed.\n");                                             /* write buffer failed */
-       
-        return 1;                                                                                          /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_sx1268_check_busy(handle);                                                                     /* check busy */
-    if (res != 0)                                                                                          /* check result */
-    {
-        handle->debug_print("sx1268: chip is busy.\n");                                                    /* chip is busy */
-       
-        return 4;                                                                                          /* return error */
-    }
+    handle->irq_status_callback = callback;                                                    /* set callback */
+    handle->irq_table = ((handle->irq_handler_mask != 0) || 
+                         (handle->irq_status_callback != NULL)) ? 1 : 0;                       /* set table mode */
     
-    reg = (uint32_t)(us / 15.625);                                                                         /* convert the timeout */
-    buffer[0] = (reg >> 16) & 0xFF;                                                                        /* bit 23 : 16 */
-    buffer[1] = (reg >> 8) & 0xFF;                                                                         /* bit 15 : 8 */
-    buffer[2] = (reg >> 0) & 0xFF;                                                                         /* bit 7 : 0 */
-    handle->tx_done = 0;                                                                                   /* flag 0 */
-    handle->timeout = 0;                                                                                   /* flag 0 */
-    res = a_sx1268_spi_write(handle, SX1268_COMMAND_SET_TX, (uint8_t *)buffer, 3);                         /* write command */
-    if (res != 0)                                                                                          /* check result */
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the rx address filter
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @param[in] header_len is the peeked header length
+ * @param[in] address_offset is the address byte offset in the header
+ * @param[in] *match points to a match function, NULL uses the accepted address set
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 header_len is invalid
+ *            - 6 address_offset is over header_len
+ * @note      1 <= header_len <= SX1268_RX_FILTER_HEADER_MAX, match returns 1 to accept the packet,
+ *            a rejected or shorter packet is neither read nor passed to the callbacks
+ */
+uint8_t sx1268_set_rx_filter(sx1268_handle_t *handle, sx1268_bool_t enable, uint8_t header_len, uint8_t address_offset,
+                             uint8_t (*match)(uint8_t *header, uint8_t len))
+{
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->debug_print("sx1268: set tx failed.\n");                                                   /* set tx failed */
-       
-        return 1;                                                                                          /* return error */
+        return 2;                                                                              /* return error */
     }
-    ms = us / 1000 + 10000;                                                                                /* set timeout */
-    while ((ms != 0) && (handle->tx_done == 0) && (handle->timeout == 0))                                  /* check timeout */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        handle->delay_ms(1);                                                                               /* delay 1 ms */
-        ms--;                                                                                              /* ms-- */
+        return 3;                                                                              /* return error */
     }
-    if ((ms != 0) && (handle->tx_done == 1))                                                               /* check the result */
+    if ((header_len == 0) || (header_len > SX1268_RX_FILTER_HEADER_MAX))                       /* check header length */
     {
-        return 0;                                                                                          /* success return 0 */
+        handle->debug_print("sx1268: header_len is invalid.\n");                               /* header_len is invalid */
+        
+        return 5;                                                                              /* return error */
     }
-    else if ((ms == 0) & (handle->tx_done == 0))                                                           /* check the result */
+    if (address_offset >= header_len)                                                          /* check offset */
     {
-        handle->debug_print("sx1268: sent timeout.\n");                                                    /* sent timeout */
-       
-        return 5;                                                                                          /* return error */
+        handle->debug_print("sx1268: address_offset is over header_len.\n");                   /* address_offset is over header_len */
+        
+        return 6;                                                                              /* return error */
     }
-    else if (handle->timeout == 1)                                                                         /* check the result */
+    
+    handle->rx_filter_enable = 0;                                                              /* stop the filter */
+    handle->rx_filter_header_len = header_len;                                                 /* set header length */
+    handle->rx_filter_address_offset = address_offset;                                         /* set address offset */
+    handle->rx_filter_match = match;                                                           /* set match */
+    handle->rx_filter_enable = (uint8_t)enable;                                                /* set enable */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the rx address filter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a bool value buffer
+ * @param[out] *header_len points to a header length buffer
+ * @param[out] *address_offset points to an address offset buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_rx_filter(sx1268_handle_t *handle, sx1268_bool_t *enable, uint8_t *header_len, uint8_t *address_offset)
+{
+    if (handle == NULL)                                                  /* check handle */
     {
-        handle->debug_print("sx1268: irq timeout.\n");                                                     /* irq timeout */
-       
-        return 6;                                                                                          /* return error */
+        return 2;                                                        /* return error */
     }
-    else
+    if (handle->inited != 1)                                             /* check handle initialization */
     {
-        handle->debug_print("sx1268: unknown result.\n");                                                  /* unknown result */
-       
-        return 7;                                                                                          /* return error */
+        return 3;                                                        /* return error */
     }
+    
+    *enable = (sx1268_bool_t)(handle->rx_filter_enable);                 /* get enable */
+    *header_len = handle->rx_filter_header_len;                          /* get header length */
+    *address_offset = handle->rx_filter_address_offset;                  /* get address offset */
+    
+    return 0;                                                            /* success return 0 */
 }
 
 /**
- * @brief     write the register
+ * @brief     add an accepted rx filter address
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] reg is the register address
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
+ * @param[in] address is the accepted address
  * @return    status code
  *            - 0 success
- *            - 1 write register failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
  * @note      none
  */
-uint8_t sx1268_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
+uint8_t sx1268_add_rx_filter_address(sx1268_handle_t *handle, uint8_t address)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                 /* check handle */
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                       /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                            /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                       /* return error */
+        return 3;                                                            /* return error */
     }
     
-    res = a_sx1268_check_busy(handle);                                  /* check busy */
-    if (res != 0)                                                       /* check result */
+    handle->rx_filter_map[address >> 3] |= (uint8_t)(1 << (address & 7));    /* set the bit */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     clear all accepted rx filter addresses
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t sx1268_clear_rx_filter_address(sx1268_handle_t *handle)
+{
+    if (handle == NULL)                                                      /* check handle */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                 /* chip is busy */
-       
-        return 4;                                                       /* return error */
+        return 2;                                                            /* return error */
     }
-    
-    if (a_sx1268_spi_write_register(handle, reg, buf, len) != 0)        /* write register */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        handle->debug_print("sx1268: write register failed.\n");        /* write register failed */
-       
-        return 1;                                                       /* return error */
+        return 3;                                                            /* return error */
     }
     
-    return 0;                                                           /* success return 0 */
+    memset(handle->rx_filter_map, 0, sizeof(uint8_t) * 32);                  /* clear the set */
+    
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief      read the register
+ * @brief      get the rx filter dropped packet counter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  reg is the register address
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
+ * @param[out] *count points to a counter buffer
  * @return     status code
  *             - 0 success
- *             - 1 read register failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
- * @note       none
- */
-uint8_t sx1268_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len)
-{
-    uint8_t res;
-    
-    if (handle == NULL)                                                /* check handle */
-    {
-        return 2;                                                      /* return error */
-    }
-    if (handle->inited != 1)                                           /* check handle initialization */
+ * @note       none
+ */
+uint8_t sx1268_get_rx_filter_dropped(sx1268_handle_t *handle, uint32_t *count)
+{
+    if (handle == NULL)                                  /* check handle */
     {
-        return 3;                                                      /* return error */
+        return 2;                                        /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                                 /* check busy */
-    if (res != 0)                                                      /* check result */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        handle->debug_print("sx1268: chip is busy.\n");                /* chip is busy */
-       
-        return 4;                                                      /* return error */
+        return 3;                                        /* return error */
     }
     
-    if (a_sx1268_spi_read_register(handle, reg, buf, len) != 0)        /* read register */
-    {
-        handle->debug_print("sx1268: read register failed.\n");        /* read register failed */
-       
-        return 1;                                                      /* return error */
-    }
+    *count = handle->rx_filter_dropped;                  /* get counter */
     
-    return 0;                                                          /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief     write the buffer
+ * @brief     set the rx buffer provider
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] offset is the buffer offset
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
+ * @param[in] *provider points to a provider function, NULL uses the inner receive buffer
+ * @param[in] *release points to a release function, it can be NULL only without a provider
  * @return    status code
  *            - 0 success
- *            - 1 write buffer failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- * @note      none
+ *            - 5 release is NULL
+ * @note      provider is called from the irq handler with the payload length and returns the buffer
+ *            the payload is read into, the length can be 0 for an empty packet, a NULL buffer drops
+ *            the packet, every buffer it hands out goes back exactly once: through the rx done
+ *            callback as the last use by the driver, after rx_packet_callback, and it belongs to the
+ *            application afterwards, or through release when reading the payload fails or no rx done
+ *            callback is registered, the rx ring is used before the provider
  */
-uint8_t sx1268_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+uint8_t sx1268_set_rx_buffer_provider(sx1268_handle_t *handle, uint8_t *(*provider)(uint16_t len),
+                                      void (*release)(uint8_t *buf))
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                               /* check handle */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                                                     /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                                                     /* return error */
+        return 3;                                        /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                                /* check busy */
-    if (res != 0)                                                     /* check result */
+    if ((provider != NULL) && (release == NULL))         /* check release */
     {
-        handle->debug_print("sx1268: chip is busy.\n");               /* chip is busy */
-       
-        return 4;                                                     /* return error */
+        handle->debug_print("sx1268: release is NULL.\n");  /* release is NULL */
+        
+        return 5;                                        /* return error */
     }
     
-    if (a_sx1268_spi_write_buffer(handle, offset, buf, len) != 0)     /* write buffer */
-    {
-        handle->debug_print("sx1268: write buffer failed.\n");        /* write buffer failed */
-       
-        return 1;                                                     /* return error */
-    }
+    handle->rx_buffer_provider = provider;               /* set provider */
+    handle->rx_buffer_release = release;                 /* set release */
     
-    return 0;                                                         /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief      read the buffer
+ * @brief      get the rx buffer provider dropped packet counter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  offset is the buffer offset
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
+ * @param[out] *count points to a counter buffer
  * @return     status code
  *             - 0 success
- *             - 1 read buffer failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
  * @note       none
  */
-uint8_t sx1268_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len)
+uint8_t sx1268_get_rx_buffer_dropped(sx1268_handle_t *handle, uint32_t *count)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                              /* check handle */
-    {
-        return 2;                                                    /* return error */
-    }
-    if (handle->inited != 1)                                         /* check handle initialization */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 3;                                                    /* return error */
+        return 2;                                        /* return error */
     }
-    
-    res = a_sx1268_check_busy(handle);                               /* check busy */
-    if (res != 0)                                                    /* check result */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        handle->debug_print("sx1268: chip is busy.\n");              /* chip is busy */
-       
-        return 4;                                                    /* return error */
+        return 3;                                        /* return error */
     }
     
-    if (a_sx1268_spi_read_buffer(handle, offset, buf, len) != 0)     /* read buffer */
-    {
-        handle->debug_print("sx1268: read buffer failed.\n");        /* read buffer failed */
-       
-        return 1;                                                    /* return error */
-    }
+    *count = handle->rx_buffer_dropped;                  /* get counter */
     
-    return 0;                                                        /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
 
 /**
@@ -1698,6 +6138,7 @@ uint8_t sx1268_set_rx(sx1268_handle_t *handle, uint32_t timeout)
     return 0;                                                                       /* success return 0 */
 }
 
+#if (SX1268_FLOAT_API == 1)
 /**
  * @brief      convert the timeout to the register raw data
  * @param[in]  *handle points to a sx1268 handle structure
@@ -1751,6 +6192,61 @@ uint8_t sx1268_timeout_convert_to_data(sx1268_handle_t *handle, uint32_t reg, do
     
     return 0;                            /* success return 0 */
 }
+#endif
+
+/**
+ * @brief      convert the integer timeout to the register raw data
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  us is the timeout in us
+ * @param[out] *reg points to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one step is 15.625 us, the result is rounded down
+ */
+uint8_t sx1268_timeout_convert_to_register_integer(sx1268_handle_t *handle, uint32_t us, uint32_t *reg)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    *reg = (uint32_t)(((uint64_t)us * 8) / 125);            /* convert real data to register data */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the integer timeout
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register raw data
+ * @param[out] *us points to a us buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one step is 15.625 us, the result is rounded down
+ */
+uint8_t sx1268_timeout_convert_to_data_integer(sx1268_handle_t *handle, uint32_t reg, uint32_t *us)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    *us = (uint32_t)(((uint64_t)reg * 125) / 8);            /* convert raw data to real data */
+    
+    return 0;                                               /* success return 0 */
+}
 
 /**
  * @brief     stop timer on preamble
@@ -2484,7 +6980,7 @@ uint8_t sx1268_frequency_convert_to_register(sx1268_handle_t *handle, uint32_t f
         return 3;                                                                 /* return error */
     }
     
-    *reg = (uint32_t)(powf(2.0f, 25.0f) / (32 * powf(10.f, 6.0f)) * freq);        /* convert real data to register data */
+    *reg = (uint32_t)(((uint64_t)freq << 25) / 32000000U);                         /* convert real data to register data */
     
     return 0;                                                                     /* success return 0 */
 }
@@ -2511,7 +7007,7 @@ uint8_t sx1268_frequency_convert_to_data(sx1268_handle_t *handle, uint32_t reg,
         return 3;                                                                 /* return error */
     }
     
-    *freq = (uint32_t)(32 * powf(10.f, 6.0f) / powf(2.0f, 25.0f) * reg);          /* convert real data to register data */
+    *freq = (uint32_t)(((uint64_t)reg * 32000000U) >> 25);                         /* convert real data to register data */
     
     return 0;                                                                     /* success return 0 */
 }
@@ -2771,6 +7267,7 @@ uint8_t sx1268_set_gfsk_modulation_params(sx1268_handle_t *handle, uint32_t br,
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 br is 0
  * @note       none
  */
 uint8_t sx1268_gfsk_bit_rate_convert_to_register(sx1268_handle_t *handle, uint32_t br, uint32_t *reg)
@@ -2783,8 +7280,14 @@ uint8_t sx1268_gfsk_bit_rate_convert_to_register(sx1268_handle_t *handle, uint32
     {
         return 3;                                                   /* return error */
     }
+    if (br == 0)                                                    /* check br */
+    {
+        handle->debug_print("sx1268: br is 0.\n");                  /* br is 0 */
+        
+        return 4;                                                   /* return error */
+    }
     
-    *reg = (uint32_t)(32 * (32 * powf(10.f, 6.0f))) / br;           /* convert real data to register data */
+    *reg = (uint32_t)(32 * 32000000U) / br;                         /* convert real data to register data */
     
     return 0;                                                       /* success return 0 */
 }
@@ -2798,6 +7301,7 @@ uint8_t sx1268_gfsk_bit_rate_convert_to_register(sx1268_handle_t *handle, uint32
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 reg is 0
  * @note       none
  */
 uint8_t sx1268_gfsk_bit_rate_convert_to_data(sx1268_handle_t *handle, uint32_t reg, uint32_t *br)
@@ -2810,8 +7314,14 @@ uint8_t sx1268_gfsk_bit_rate_convert_to_data(sx1268_handle_t *handle, uint32_t r
     {
         return 3;                                                /* return error */
     }
+    if (reg == 0)                                                /* check reg */
+    {
+        handle->debug_print("sx1268: reg is 0.\n");              /* reg is 0 */
+        
+        return 4;                                                /* return error */
+    }
     
-    *br = (uint32_t)(32 * 32 * powf(10.f, 6.0f) / reg);          /* convert real data to register data */
+    *br = (uint32_t)(32 * 32000000U) / reg;                      /* convert real data to register data */
     
     return 0;                                                    /* success return 0 */
 }
@@ -2838,7 +7348,7 @@ uint8_t sx1268_gfsk_frequency_deviation_convert_to_register(sx1268_handle_t *han
         return 3;                                                                 /* return error */
     }
     
-    *reg = (uint32_t)(powf(2.0f, 25.0f) * freq / (32 * powf(10.f, 6.0f)));        /* convert real data to register data */
+    *reg = (uint32_t)(((uint64_t)freq << 25) / 32000000U);                         /* convert real data to register data */
     
     return 0;                                                                     /* success return 0 */
 }
@@ -2865,7 +7375,7 @@ uint8_t sx1268_gfsk_frequency_deviation_convert_to_data(sx1268_handle_t *handle,
         return 3;                                                                 /* return error */
     }
     
-    *freq = (uint32_t)(32 * powf(10.f, 6.0f) / powf(2.0f, 25.0f) * reg);          /* convert real data to register data */
+    *freq = (uint32_t)(((uint64_t)reg * 32000000U) >> 25);                         /* convert real data to register data */
     
     return 0;                                                                     /* success return 0 */
 }
@@ -3299,6 +7809,7 @@ uint8_t sx1268_get_rx_buffer_status(sx1268_handle_t *handle, uint8_t *payload_le
     return 0;                                                                                      /* success return 0 */
 }
 
+#if (SX1268_FLOAT_API == 1)
 /**
  * @brief      get the packet status in GFSK mode
  * @param[in]  *handle points to a sx1268 handle structure
@@ -3458,6 +7969,155 @@ uint8_t sx1268_get_instantaneous_rssi(sx1268_handle_t *handle, uint8_t *rssi_ins
     
     return 0;                                                                               /* success return 0 */
 }
+#endif
+
+/**
+ * @brief      get the packet status in GFSK mode with integer results
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rx_status points to a rx status buffer
+ * @param[out] *rssi_sync points to a rssi sync buffer in 0.01 dBm
+ * @param[out] *rssi_avg points to a rssi avg buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gfsk packet status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_gfsk_packet_status_integer(sx1268_handle_t *handle, uint8_t *rx_status, 
+                                              int16_t *rssi_sync, int16_t *rssi_avg)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_PACKET_STATUS, (uint8_t *)buf, 4);       /* read command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: get packet status failed.\n");                             /* get packet status failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    *rx_status = buf[1];                                                                        /* set status */
+    *rssi_sync = -(int16_t)buf[2] * 50;                                                         /* set status */
+    *rssi_avg = -(int16_t)buf[3] * 50;                                                          /* set status */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the packet status in LoRa mode with integer results
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rssi_pkt points to a rssi packet buffer in 0.01 dBm
+ * @param[out] *snr_pkt points to a snr packet buffer in 0.01 dB
+ * @param[out] *signal_rssi_pkt points to a signal rssi packet buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get lora packet status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_lora_packet_status_integer(sx1268_handle_t *handle, int16_t *rssi_pkt, 
+                                              int16_t *snr_pkt, int16_t *signal_rssi_pkt)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                          /* check busy */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                         /* chip is busy */
+       
+        return 4;                                                                               /* return error */
+    }
+    
+    res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_PACKET_STATUS, (uint8_t *)buf, 4);       /* read command */
+    if (res != 0)                                                                               /* check result */
+    {
+        handle->debug_print("sx1268: get packet status failed.\n");                             /* get packet status failed */
+       
+        return 1;                                                                               /* return error */
+    }
+    *rssi_pkt = -(int16_t)buf[1] * 50;                                                          /* set status */
+    *snr_pkt = (int16_t)((int8_t)buf[2]) * 25;                                                  /* snr is signed */
+    *signal_rssi_pkt = -(int16_t)buf[3] * 50;                                                   /* set status */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the instantaneous rssi with an integer result
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rssi_inst points to a rssi instantaneous buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get instantaneous rssi failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_instantaneous_rssi_integer(sx1268_handle_t *handle, int16_t *rssi_inst)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    res = a_sx1268_check_busy(handle);                                                      /* check busy */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: chip is busy.\n");                                     /* chip is busy */
+       
+        return 4;                                                                           /* return error */
+    }
+    
+    res = a_sx1268_spi_read(handle, SX1268_COMMAND_GET_RSSI_LNST, (uint8_t *)buf, 2);       /* read command */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("sx1268: get instantaneous rssi failed.\n");                    /* get instantaneous rssi failed */
+       
+        return 1;                                                                           /* return error */
+    }
+    *rssi_inst = -(int16_t)buf[1] * 50;                                                     /* set status */
+    
+    return 0;                                                                               /* success return 0 */
+}
 
 /**
  * @brief      get the stats
@@ -123,6 +123,26 @@ typedef enum
     SX1268_IRQ_TIMEOUT           = (1 << 9),        /**< timeout */
 } sx1268_irq_t;
 
+/**
+ * @brief sx1268 irq profile enumeration definition
+ */
+typedef enum
+{
+    SX1268_IRQ_PROFILE_ALL        = 0x00,        /**< every enabled irq raises dio1 */
+    SX1268_IRQ_PROFILE_COMPLETION = 0x01,        /**< only completion irqs raise dio1, the others stay latched */
+    SX1268_IRQ_PROFILE_MULTI_LINE = 0x02,        /**< rx done raises dio1, the other completion irqs raise dio2 */
+} sx1268_irq_profile_t;
+
+/**
+ * @brief sx1268 dio line enumeration definition
+ */
+typedef enum
+{
+    SX1268_DIO_LINE_1 = 0x00,        /**< dio1 */
+    SX1268_DIO_LINE_2 = 0x01,        /**< dio2 */
+    SX1268_DIO_LINE_3 = 0x02,        /**< dio3 */
+} sx1268_dio_line_t;
+
 /**
  * @brief sx1268 rx tx fallback mode enumeration definition
  */
@@ -372,6 +392,299 @@ typedef enum
     SX1268_OP_ERROR_RC64K_CALIB_ERR = (1 << 0),        /**< rc64k calibration failed */
 } sx1268_op_error_t;
 
+/**
+ * @brief sx1268 status chip mode enumeration definition
+ */
+typedef enum
+{
+    SX1268_CHIP_MODE_UNUSED       = 0x00,        /**< unused */
+    SX1268_CHIP_MODE_RFU          = 0x01,        /**< rfu */
+    SX1268_CHIP_MODE_STBY_RC      = 0x02,        /**< stby rc */
+    SX1268_CHIP_MODE_STBY_XOSC    = 0x03,        /**< stby xosc */
+    SX1268_CHIP_MODE_FS           = 0x04,        /**< fs */
+    SX1268_CHIP_MODE_RX           = 0x05,        /**< rx */
+    SX1268_CHIP_MODE_TX           = 0x06,        /**< tx */
+} sx1268_chip_mode_t;
+
+/**
+ * @brief sx1268 status command status enumeration definition
+ */
+typedef enum
+{
+    SX1268_COMMAND_STATUS_RESERVED            = 0x00,        /**< reserved */
+    SX1268_COMMAND_STATUS_RFU                 = 0x01,        /**< rfu */
+    SX1268_COMMAND_STATUS_DATA_AVAILABLE      = 0x02,        /**< data is available to host */
+    SX1268_COMMAND_STATUS_TIMEOUT             = 0x03,        /**< command timeout */
+    SX1268_COMMAND_STATUS_PROCESSING_ERROR    = 0x04,        /**< command processing error */
+    SX1268_COMMAND_STATUS_EXECUTE_FAILURE     = 0x05,        /**< failure to execute command */
+    SX1268_COMMAND_STATUS_TX_DONE             = 0x06,        /**< command tx done */
+} sx1268_command_status_t;
+
+/**
+ * @brief sx1268 chip state enumeration definition
+ */
+typedef enum
+{
+    SX1268_CHIP_STATE_UNKNOWN      = 0x00,        /**< unknown */
+    SX1268_CHIP_STATE_SLEEP        = 0x01,        /**< sleep */
+    SX1268_CHIP_STATE_STANDBY_RC   = 0x02,        /**< standby rc */
+    SX1268_CHIP_STATE_STANDBY_XOSC = 0x03,        /**< standby xosc */
+    SX1268_CHIP_STATE_FS           = 0x04,        /**< frequency synthesis */
+    SX1268_CHIP_STATE_TX           = 0x05,        /**< tx */
+    SX1268_CHIP_STATE_RX           = 0x06,        /**< rx */
+    SX1268_CHIP_STATE_CAD          = 0x07,        /**< cad */
+} sx1268_chip_state_t;
+
+/**
+ * @brief sx1268 hop mode enumeration definition
+ */
+typedef enum
+{
+    SX1268_HOP_MODE_ROUND_ROBIN = 0x00,        /**< round robin sequence */
+    SX1268_HOP_MODE_RANDOM      = 0x01,        /**< pseudo random sequence */
+} sx1268_hop_mode_t;
+
+/**
+ * @brief sx1268 operation enumeration definition
+ */
+typedef enum
+{
+    SX1268_OPERATION_NONE = 0x00,        /**< no operation */
+    SX1268_OPERATION_TX   = 0x01,        /**< transmit */
+    SX1268_OPERATION_RX   = 0x02,        /**< receive */
+    SX1268_OPERATION_CAD  = 0x03,        /**< channel activity detection */
+} sx1268_operation_t;
+
+/**
+ * @brief sx1268 operation status enumeration definition
+ */
+typedef enum
+{
+    SX1268_OPERATION_STATUS_IDLE         = 0x00,        /**< no operation started */
+    SX1268_OPERATION_STATUS_RUNNING      = 0x01,        /**< waiting for the irq */
+    SX1268_OPERATION_STATUS_DONE         = 0x02,        /**< tx done, rx done or cad done without activity */
+    SX1268_OPERATION_STATUS_TIMEOUT      = 0x03,        /**< tx or rx timeout */
+    SX1268_OPERATION_STATUS_CRC_ERROR    = 0x04,        /**< rx done with crc error */
+    SX1268_OPERATION_STATUS_CAD_DETECTED = 0x05,        /**< cad done with activity */
+} sx1268_operation_status_t;
+
+/**
+ * @brief sx1268 tx priority enumeration definition
+ */
+typedef enum
+{
+    SX1268_TX_PRIORITY_HIGH   = 0x00,        /**< high priority */
+    SX1268_TX_PRIORITY_NORMAL = 0x01,        /**< normal priority */
+    SX1268_TX_PRIORITY_LOW    = 0x02,        /**< low priority */
+} sx1268_tx_priority_t;
+
+/**
+ * @brief sx1268 spi segment structure definition
+ */
+typedef struct sx1268_spi_segment_s
+{
+    uint8_t *tx_buf;        /**< tx buffer, NULL means clocking out zero */
+    uint8_t *rx_buf;        /**< rx buffer, NULL means dropping the received data */
+    uint32_t len;           /**< segment length */
+    uint8_t cs_change;      /**< deassert the chip select after this segment */
+    uint16_t delay_us;      /**< delay in us with the chip select high after a cs_change segment */
+} sx1268_spi_segment_t;
+
+/**
+ * @brief sx1268 hop channel structure definition
+ */
+typedef struct sx1268_hop_channel_s
+{
+    uint8_t frequency[4];        /**< set rf frequency payload */
+    uint8_t image[2];            /**< calibrate image payload */
+    uint8_t blacklist;           /**< blacklist flag */
+} sx1268_hop_channel_t;
+
+/**
+ * @brief sx1268 batch max command number definition
+ */
+#ifndef SX1268_BATCH_MAX_NUM
+    #define SX1268_BATCH_MAX_NUM        32         /**< 32 commands */
+#endif
+
+/**
+ * @brief sx1268 batch buffer size definition
+ */
+#ifndef SX1268_BATCH_BUFFER_SIZE
+    #define SX1268_BATCH_BUFFER_SIZE    256        /**< 256 bytes */
+#endif
+
+/**
+ * @brief sx1268 register cache size definition
+ */
+#define SX1268_REGISTER_CACHE_SIZE        27             /**< 27 registers */
+
+/**
+ * @brief sx1268 configuration shadow definition
+ */
+#define SX1268_CONFIG_SHADOW_NUM          5              /**< modulation, packet, frequency, tx and buffer base */
+#define SX1268_CONFIG_SHADOW_SIZE         9              /**< longest param length */
+
+/**
+ * @brief sx1268 scatter gather register max number definition
+ */
+#ifndef SX1268_REGISTERS_MAX_NUM
+    #define SX1268_REGISTERS_MAX_NUM      64             /**< 64 registers */
+#endif
+
+/**
+ * @brief sx1268 fast start reset pulse definition
+ */
+#ifndef SX1268_FAST_START_RESET_PULSE_US
+    #define SX1268_FAST_START_RESET_PULSE_US    100      /**< 100 us reset pulse */
+#endif
+
+/**
+ * @brief sx1268 retention list max number definition
+ */
+#define SX1268_RETENTION_LIST_MAX_NUM     4              /**< 4 registers */
+
+/**
+ * @brief sx1268 float api definition
+ * @note  set it to 0 to build the driver and the example without float or double math,
+ *        only the fields of sx1268_info_t stay float
+ */
+#ifndef SX1268_FLOAT_API
+    #define SX1268_FLOAT_API              1              /**< enable the float api */
+#endif
+
+/**
+ * @brief sx1268 tx pipeline half size definition
+ */
+#define SX1268_TX_PIPELINE_HALF_SIZE      128            /**< two frames of 128 bytes */
+
+/**
+ * @brief sx1268 tx queue priority number definition
+ */
+#define SX1268_TX_QUEUE_PRIORITY_NUM      3              /**< high, normal and low */
+
+/**
+ * @brief sx1268 tx queue depth definition
+ * @note  it must be a power of 2
+ */
+#ifndef SX1268_TX_QUEUE_DEPTH
+    #define SX1268_TX_QUEUE_DEPTH         8              /**< 8 frames per priority */
+#endif
+
+/**
+ * @brief sx1268 tx queue atomic definition
+ * @note  override them if the compiler has no gnu sync builtins
+ */
+#ifndef SX1268_TX_QUEUE_CAS
+    #define SX1268_TX_QUEUE_CAS(ptr, old, new)    __sync_bool_compare_and_swap((ptr), (old), (new))    /**< compare and swap */
+#endif
+#ifndef SX1268_TX_QUEUE_BARRIER
+    #define SX1268_TX_QUEUE_BARRIER()             __sync_synchronize()                                 /**< full memory barrier */
+#endif
+
+/**
+ * @brief sx1268 rx ring definition
+ * @note  every slot starts with a 2 bytes little endian length
+ */
+#define SX1268_RX_RING_HEADER_SIZE        2              /**< 2 bytes length */
+#ifndef SX1268_RX_RING_BARRIER
+    #define SX1268_RX_RING_BARRIER()      __sync_synchronize()    /**< full memory barrier */
+#endif
+
+/**
+ * @brief sx1268 receive buffer definition
+ * @note  set 0 to remove the inner 256 bytes receive buffer, then use a rx buffer provider or the rx ring
+ */
+#ifndef SX1268_RECEIVE_BUFFER_ENABLE
+    #define SX1268_RECEIVE_BUFFER_ENABLE  1              /**< enable the inner receive buffer */
+#endif
+
+/**
+ * @brief sx1268 rx filter definition
+ */
+#define SX1268_RX_FILTER_HEADER_MAX       16             /**< max peeked header bytes */
+
+/**
+ * @brief sx1268 irq completion mask definition
+ */
+#define SX1268_IRQ_COMPLETION_MASK        (SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE | \
+                                           SX1268_IRQ_TIMEOUT | SX1268_IRQ_CAD_DONE)    /**< completion irqs */
+
+/**
+ * @brief sx1268 irq fast path gap definition
+ * @note  the gap is waited with the chip select high after clear irq status and get rx buffer status,
+ *        it replaces the busy poll and must cover the busy time of both commands
+ */
+#ifndef SX1268_IRQ_FAST_PATH_GAP_US
+    #define SX1268_IRQ_FAST_PATH_GAP_US   2              /**< 2 us */
+#endif
+
+/**
+ * @brief sx1268 irq handler number definition
+ */
+#define SX1268_IRQ_HANDLER_NUM            10             /**< one handler per irq bit */
+
+/**
+ * @brief sx1268 irq event queue definition
+ * @note  the depth must be a power of 2 and not over 128
+ */
+#ifndef SX1268_IRQ_EVENT_QUEUE_DEPTH
+    #define SX1268_IRQ_EVENT_QUEUE_DEPTH  8              /**< 8 events */
+#endif
+#ifndef SX1268_IRQ_EVENT_BARRIER
+    #define SX1268_IRQ_EVENT_BARRIER()    __sync_synchronize()    /**< full memory barrier */
+#endif
+
+/**
+ * @brief sx1268 busy wait default definition
+ */
+#define SX1268_BUSY_DEFAULT_SPIN          64             /**< spin 64 times */
+#define SX1268_BUSY_DEFAULT_STEP_US       10             /**< yield 10 us */
+#define SX1268_BUSY_DEFAULT_TIMEOUT_US    1000000        /**< 1 s */
+
+/**
+ * @brief sx1268 tx queue slot structure definition
+ */
+typedef struct sx1268_tx_slot_s
+{
+    volatile uint32_t seq;        /**< slot sequence */
+    uint8_t *buf;                 /**< frame buffer */
+    uint16_t len;                 /**< frame length */
+} sx1268_tx_slot_t;
+
+/**
+ * @brief sx1268 tx queue structure definition
+ */
+typedef struct sx1268_tx_queue_s
+{
+    volatile uint32_t head;                          /**< dequeue position */
+    volatile uint32_t tail;                          /**< enqueue position */
+    sx1268_tx_slot_t slot[SX1268_TX_QUEUE_DEPTH];    /**< slots */
+} sx1268_tx_queue_t;
+
+/**
+ * @brief sx1268 rx packet structure definition
+ */
+typedef struct sx1268_rx_packet_s
+{
+    uint8_t *payload;                   /**< payload, NULL with crc error or the rx ring, only valid in the callback */
+    uint8_t len;                        /**< payload length */
+    uint8_t crc_error;                  /**< crc error flag */
+    uint8_t packet_type;                /**< packet type of the packet status */
+    uint8_t rssi_pkt_raw;               /**< raw rssi of the packet, lora only */
+    uint8_t snr_pkt_raw;                /**< raw snr of the packet, lora only */
+    uint8_t signal_rssi_pkt_raw;        /**< raw signal rssi of the packet, lora only */
+    int16_t rssi_pkt;                   /**< rssi of the packet in 0.01 dBm, lora only */
+    int16_t snr_pkt;                    /**< snr of the packet in 0.01 dB, lora only */
+    int16_t signal_rssi_pkt;            /**< signal rssi of the packet in 0.01 dBm, lora only */
+    uint8_t rx_status_raw;              /**< raw rx status, gfsk only */
+    uint8_t rssi_sync_raw;              /**< raw rssi at the sync word, gfsk only */
+    uint8_t rssi_avg_raw;               /**< raw average rssi, gfsk only */
+    int16_t rssi_sync;                  /**< rssi at the sync word in 0.01 dBm, gfsk only */
+    int16_t rssi_avg;                   /**< average rssi of the packet in 0.01 dBm, gfsk only */
+    uint32_t timestamp_us;              /**< irq handler entry time in us, 0 without the get_time_us link */
+} sx1268_rx_packet_t;
+
 /**
  * @brief sx1268 handle structure definition
  */
@@ -387,18 +700,120 @@ typedef struct sx1268_handle_s
     uint8_t (*spi_deinit)(void);                                          /**< point to a spi_deinit function address */
     uint8_t (*spi_write_read)(uint8_t *in_buf, uint32_t in_len,
                               uint8_t *out_buf, uint32_t out_len);        /**< point to a spi_write_read function address */
+    uint8_t (*spi_writev)(sx1268_spi_segment_t *seg, uint8_t num);        /**< point to a spi_writev function address */
     void (*delay_ms)(uint32_t ms);                                        /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                        /**< point to a delay_us function address */
+    uint8_t (*get_time_us)(uint32_t *us);                                 /**< point to a get_time_us function address */
     void (*debug_print)(const char *const fmt, ...);                      /**< point to a debug_print function address */
     void (*receive_callback)(uint16_t type,
                              uint8_t *buf, uint16_t len);                 /**< point to a receive_callback function address */
+    void (*rx_packet_callback)(sx1268_rx_packet_t *packet);               /**< point to a rx_packet_callback function address */
+    void (*irq_handler[SX1268_IRQ_HANDLER_NUM])(uint8_t *buf, uint16_t len);    /**< per irq handler table */
+    void (*irq_status_callback)(uint16_t status);                         /**< irq status word callback */
+    uint16_t irq_handler_mask;                                            /**< registered irq handler bits */
+    uint8_t irq_table;                                                    /**< irq handler table enable flag */
+    volatile uint32_t irq_event_time[SX1268_IRQ_EVENT_QUEUE_DEPTH];       /**< irq event timestamps */
+    volatile uint8_t irq_event_line[SX1268_IRQ_EVENT_QUEUE_DEPTH];        /**< irq event dio lines */
+    volatile uint8_t irq_event_head;                                      /**< irq event read position */
+    volatile uint8_t irq_event_tail;                                      /**< irq event write position */
+    volatile uint32_t irq_event_overflow;                                 /**< irq event overflow counter */
+    volatile uint8_t irq_event_lost;                                      /**< irq event lost flag */
+    uint8_t irq_profile;                                                  /**< irq profile */
+    uint16_t irq_mask;                                                    /**< enabled irq mask */
+    uint16_t irq_line_mask[3];                                            /**< dio1, dio2 and dio3 irq mask */
+    uint32_t irq_stat_irq;                                                /**< host interrupt counter */
+    uint32_t irq_stat_packet;                                             /**< tx and rx packet counter */
+    uint16_t irq_stat_since;                                              /**< host interrupts since the last packet */
+    uint16_t irq_stat_last;                                               /**< host interrupts of the last packet */
     uint8_t inited;                                                       /**< inited flag */
     uint8_t tx_done;                                                      /**< tx done flag */
     uint8_t cad_done;                                                     /**< cad done flag */
     uint8_t cad_detected;                                                 /**< cad detected flag */
     uint8_t crc_error;                                                    /**< crc error flag */
     uint8_t timeout;                                                      /**< timeout flag */
+    uint8_t state;                                                        /**< last commanded chip state */
+    uint8_t fallback_state;                                               /**< chip state after tx or rx */
+    uint8_t rx_continuous;                                                /**< rx continuous flag */
+    uint8_t cad_exit_rx;                                                  /**< cad exit to rx flag */
+    uint8_t status;                                                       /**< status byte of the last read */
+    uint32_t command_error_cnt;                                           /**< command error counter */
+    uint16_t busy_spin;                                                   /**< busy spin times before yielding */
+    uint16_t busy_step_us;                                                /**< busy yield step in us */
+    uint32_t busy_timeout_us;                                             /**< busy timeout in us */
+    uint32_t busy_time_us;                                                /**< last busy wait time in us */
+    uint32_t busy_time_max_us;                                            /**< max busy wait time in us */
+    uint8_t fast_start;                                                   /**< fast start flag */
+    uint32_t start_time_us;                                               /**< power on to standby time in us */
+    uint8_t reg_cache_enable;                                             /**< register cache enable flag */
+    uint32_t reg_cache_valid;                                             /**< register cache valid bits */
+    uint8_t reg_cache[SX1268_REGISTER_CACHE_SIZE];                        /**< register cache */
+    uint32_t reg_cache_lost;                                              /**< register cache lost bits */
+    uint16_t retention_reg[SX1268_RETENTION_LIST_MAX_NUM];                /**< retention list */
+    uint8_t retention_num;                                                /**< retention list number */
+    sx1268_hop_channel_t *hop_table;                                      /**< hop channel table */
+    uint8_t hop_num;                                                      /**< hop channel number */
+    uint8_t hop_channel;                                                  /**< current hop channel */
+    uint8_t hop_mode;                                                     /**< hop mode */
+    uint8_t hop_enable;                                                   /**< hop on completion flag */
+    uint8_t hop_image[2];                                                 /**< last calibrated image */
+    uint32_t hop_seed;                                                    /**< hop random seed */
+    uint8_t operation;                                                    /**< started operation */
+    uint8_t operation_status;                                             /**< started operation status */
+    uint8_t irq_fast;                                                     /**< irq fast path flag */
+    sx1268_tx_queue_t tx_queue[SX1268_TX_QUEUE_PRIORITY_NUM];             /**< tx queue per priority */
+    uint8_t tx_queue_enable;                                              /**< tx queue enable flag */
+    volatile uint32_t tx_queue_active;                                    /**< queued frame dispatcher flag */
+    volatile uint8_t tx_queue_retry;                                      /**< frame failed to start flag */
+    uint8_t *tx_queue_buf;                                                /**< queued frame on air */
+    uint16_t tx_queue_len;                                                /**< queued frame on air length */
+    uint8_t tx_queue_standby;                                             /**< tx queue standby clock source */
+    uint16_t tx_queue_preamble;                                           /**< tx queue preamble length */
+    uint8_t tx_queue_header;                                              /**< tx queue header type */
+    uint8_t tx_queue_crc;                                                 /**< tx queue crc type */
+    uint8_t tx_queue_iq;                                                  /**< tx queue invert iq flag */
+    uint32_t tx_queue_timeout_us;                                         /**< tx queue tx timeout in us */
+    uint8_t *rx_ring_buf;                                                 /**< rx ring buffer */
+    uint16_t rx_ring_slot_size;                                           /**< rx ring slot size */
+    uint8_t rx_ring_depth;                                                /**< rx ring slot number */
+    volatile uint32_t rx_ring_head;                                       /**< rx ring read position */
+    volatile uint32_t rx_ring_tail;                                       /**< rx ring write position */
+    volatile uint32_t rx_ring_overflow;                                   /**< rx ring dropped packet counter */
+    uint8_t (*rx_filter_match)(uint8_t *header, uint8_t len);             /**< rx filter match function */
+    uint8_t rx_filter_enable;                                             /**< rx filter enable flag */
+    uint8_t rx_filter_header_len;                                         /**< rx filter peeked header length */
+    uint8_t rx_filter_address_offset;                                     /**< rx filter address offset in the header */
+    uint8_t rx_filter_map[32];                                            /**< rx filter accepted address bitmap */
+    volatile uint32_t rx_filter_dropped;                                  /**< rx filter dropped packet counter */
+    uint8_t *(*rx_buffer_provider)(uint16_t len);                         /**< rx buffer provider function */
+    void (*rx_buffer_release)(uint8_t *buf);                              /**< rx buffer release function */
+    volatile uint32_t rx_buffer_dropped;                                  /**< rx buffer provider dropped packet counter */
+    uint8_t tx_base;                                                      /**< tx buffer base address */
+    uint8_t rx_base;                                                      /**< rx buffer base address */
+    uint8_t packet_type;                                                  /**< packet type */
+    uint8_t tx_pipe_next;                                                 /**< tx pipeline next half */
+    uint8_t tx_pipe_staged;                                               /**< tx pipeline staged flag */
+    uint8_t tx_pipe_len;                                                  /**< tx pipeline staged length */
+    uint8_t config_diff;                                                  /**< configuration diff flag */
+    uint8_t config_force;                                                 /**< configuration force flag */
+    uint8_t config_valid;                                                 /**< configuration shadow valid bits */
+    uint8_t config_len[SX1268_CONFIG_SHADOW_NUM];                         /**< configuration shadow length */
+    uint8_t config_shadow[SX1268_CONFIG_SHADOW_NUM][SX1268_CONFIG_SHADOW_SIZE];   /**< configuration shadow */
+    uint8_t *capture_buf;                                                 /**< configuration capture buffer */
+    uint16_t capture_size;                                                /**< configuration capture buffer size */
+    uint16_t capture_len;                                                 /**< configuration capture length */
+    uint8_t capture;                                                      /**< configuration capture flag */
+    uint8_t capture_overflow;                                             /**< configuration capture overflow flag */
+    uint8_t irq_active;                                                   /**< irq processing flag */
+    uint8_t batch;                                                        /**< batch flag */
+    uint8_t batch_num;                                                    /**< batch command number */
+    uint16_t batch_len;                                                   /**< batch buffer length */
+    uint16_t batch_gap_us;                                                /**< batch gap between commands in us */
+    sx1268_spi_segment_t batch_seg[SX1268_BATCH_MAX_NUM];                 /**< batch segment list */
+    uint8_t batch_buf[SX1268_BATCH_BUFFER_SIZE];                          /**< batch buffer */
     uint8_t buf[384];                                                     /**< inner buffer */
+#if (SX1268_RECEIVE_BUFFER_ENABLE == 1)
     uint8_t receive_buf[256];                                             /**< receive buffer */
+#endif
 } sx1268_handle_t;
 
 /**
@@ -460,6 +875,17 @@ typedef struct sx1268_info_s
  */
 #define DRIVER_SX1268_LINK_SPI_WRITE_READ(HANDLE, FUC)            (HANDLE)->spi_write_read = FUC
 
+/**
+ * @brief     link spi_writev function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a spi_writev function address
+ * @note      optional, segments share one chip select cycle unless cs_change is set, after a
+ *            cs_change segment the port must raise the chip select, wait delay_us and then start
+ *            the next segment, busy only rises after the chip select goes high so the gap must
+ *            not be spent with the chip select low
+ */
+#define DRIVER_SX1268_LINK_SPI_WRITEV(HANDLE, FUC)                (HANDLE)->spi_writev = FUC
+
 /**
  * @brief     link reset_gpio_init function
  * @param[in] HANDLE points to a sx1268 handle structure
@@ -506,240 +932,1145 @@ typedef struct sx1268_info_s
  * @param[in] FUC points to a busy_gpio_read function address
  * @note      none
  */
-#define DRIVER_SX1268_LINK_BUSY_GPIO_READ(HANDLE, FUC)            (HANDLE)->busy_gpio_read = FUC
+#define DRIVER_SX1268_LINK_BUSY_GPIO_READ(HANDLE, FUC)            (HANDLE)->busy_gpio_read = FUC
+
+/**
+ * @brief     link delay_ms function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a delay_ms function address
+ * @note      none
+ */
+#define DRIVER_SX1268_LINK_DELAY_MS(HANDLE, FUC)                  (HANDLE)->delay_ms = FUC
+
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a delay_us function address
+ * @note      optional, used by the busy wait
+ */
+#define DRIVER_SX1268_LINK_DELAY_US(HANDLE, FUC)                  (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link get_time_us function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a get_time_us function address
+ * @note      optional, a monotonic us counter used by the busy wait
+ */
+#define DRIVER_SX1268_LINK_GET_TIME_US(HANDLE, FUC)               (HANDLE)->get_time_us = FUC
+
+/**
+ * @brief     link debug_print function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a debug_print function address
+ * @note      none
+ */
+#define DRIVER_SX1268_LINK_DEBUG_PRINT(HANDLE, FUC)               (HANDLE)->debug_print = FUC
+
+/**
+ * @brief     link receive_callback function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a receive_callback function address
+ * @note      none
+ */
+#define DRIVER_SX1268_LINK_RECEIVE_CALLBACK(HANDLE, FUC)          (HANDLE)->receive_callback = FUC
+
+/**
+ * @brief     link rx_packet_callback function
+ * @param[in] HANDLE points to a sx1268 handle structure
+ * @param[in] FUC points to a rx_packet_callback function address
+ * @note      optional, when linked the irq handler reads the packet status right after the
+ *            rx buffer status and before any callback runs, and delivers one packet descriptor
+ *            after every rx done, the status is decoded by the last packet type sent to the chip,
+ *            the fields of the other packet type are 0
+ */
+#define DRIVER_SX1268_LINK_RX_PACKET_CALLBACK(HANDLE, FUC)        (HANDLE)->rx_packet_callback = FUC
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup sx1268_command_driver sx1268 command driver function
+ * @brief    sx1268 command driver modules
+ * @ingroup  sx1268_driver
+ * @{
+ */
+
+/**
+ * @brief      get chip's information
+ * @param[out] *info points to a sx1268 info structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t sx1268_info(sx1268_info_t *info);
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t sx1268_irq_handler(sx1268_handle_t *handle);
+
+/**
+ * @brief     irq top half
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 event queue is full
+ * @note      it is isr safe and only records the edge time, no spi transfer is done,
+ *            a full queue loses the event, the next bottom half then reads and clears the whole
+ *            irq status once, so a dio line held high by the lost irq is released
+ */
+uint8_t sx1268_irq_top_half(sx1268_handle_t *handle);
+
+/**
+ * @brief     irq top half of one dio line
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] line is the dio line which fired
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 event queue is full
+ *            - 6 line is invalid
+ * @note      it is isr safe, sx1268_irq_bottom_half handles the event like sx1268_irq_line_handler
+ */
+uint8_t sx1268_irq_line_top_half(sx1268_handle_t *handle, sx1268_dio_line_t line);
+
+/**
+ * @brief      irq bottom half
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *num points to a processed event number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       run it from the main loop or a work queue, it does all spi transfers of the
+ *             events recorded by sx1268_irq_top_half and runs the callbacks, after an event was
+ *             lost on a full queue the whole irq status is read and cleared once more
+ */
+uint8_t sx1268_irq_bottom_half(sx1268_handle_t *handle, uint8_t *num);
+
+/**
+ * @brief      get the irq event overflow counter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *count points to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_irq_event_overflow(sx1268_handle_t *handle, uint32_t *count);
+
+/**
+ * @brief     irq handler of one dio line
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] line is the dio line which fired
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 line is invalid
+ * @note      if the line only carries one irq the cause is known, the irq status is not read and
+ *            every bit not routed to another line is cleared, else the status is read and only the
+ *            bits of this line and the bits routed to no line are handled,
+ *            rx done is only known when SX1268_IRQ_CRC_ERR is not enabled, so the skip trades the
+ *            crc check away: a payload with a crc error is delivered as a valid rx done,
+ *            keep SX1268_IRQ_CRC_ERR enabled when corrupt payloads must be dropped
+ */
+uint8_t sx1268_irq_line_handler(sx1268_handle_t *handle, sx1268_dio_line_t line);
+
+/**
+ * @brief     set the irq profile
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] profile is the irq profile
+ * @param[in] irq_mask is the enabled irq mask
+ * @return    status code
+ *            - 0 success
+ *            - 1 set irq profile failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      all bits of irq_mask are latched in the irq status, with the completion profile only
+ *            SX1268_IRQ_COMPLETION_MASK is routed to dio1 and the other bits are read with the completion irq,
+ *            the multi line profile routes rx done alone to dio1 and the other completion irqs to dio2,
+ *            so dio2 can't be used as the rf switch control and tx done only skips the irq status read
+ *            when SX1268_IRQ_TIMEOUT and SX1268_IRQ_CAD_DONE are not enabled
+ */
+uint8_t sx1268_set_irq_profile(sx1268_handle_t *handle, sx1268_irq_profile_t profile, uint16_t irq_mask);
+
+/**
+ * @brief      get the irq profile
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *profile points to an irq profile buffer
+ * @param[out] *irq_mask points to an enabled irq mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the values are the last ones sent to the chip, no bus access is done
+ */
+uint8_t sx1268_get_irq_profile(sx1268_handle_t *handle, sx1268_irq_profile_t *profile, uint16_t *irq_mask);
+
+/**
+ * @brief      get the host interrupt statistics
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *irq_num points to a host interrupt number buffer
+ * @param[out] *packet_num points to a tx and rx packet number buffer
+ * @param[out] *irq_per_packet points to a host interrupt number of the last packet buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the average host interrupts per packet is irq_num / packet_num
+ */
+uint8_t sx1268_get_irq_statistics(sx1268_handle_t *handle, uint32_t *irq_num, uint32_t *packet_num, uint16_t *irq_per_packet);
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 reset gpio initialization failed
+ *            - 5 busy gpio initialization failed
+ *            - 6 reset chip failed
+ * @note      with the fast start mode the reset pulse is shortened and the busy pin
+ *            replaces the fixed reset delays
+ */
+uint8_t sx1268_init(sx1268_handle_t *handle);
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 power down failed
+ *            - 6 busy gpio deinit failed
+ *            - 7 reset gpio deinit failed
+ * @note      none
+ */
+uint8_t sx1268_deinit(sx1268_handle_t *handle);
+
+/**
+ * @brief     sent the lora data
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 sent failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 sent timeout
+ *            - 6 irq timeout
+ *            - 7 unknown result
+ *            - 8 len is over the tx buffer
+ * @note      len must not be over 256 - tx base address
+ */
+uint8_t sx1268_lora_transmit(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                             uint16_t preamble_length, sx1268_lora_header_t header_type,
+                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
+                             uint8_t *buf, uint16_t len, uint32_t us);
+
+/**
+ * @brief      run the cad
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a enable buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 lora cad failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 cad timeout
+ * @note       none
+ */
+uint8_t sx1268_lora_cad(sx1268_handle_t *handle, sx1268_bool_t *enable);
+
+/**
+ * @brief     start sending the lora data without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 sent failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 len is over the tx buffer
+ * @note      returns right after SetTx, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status, len must not be over
+ *            256 - tx base address
+ */
+uint8_t sx1268_lora_transmit_start(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                                   uint16_t preamble_length, sx1268_lora_header_t header_type,
+                                   sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
+                                   uint8_t *buf, uint16_t len, uint32_t us);
+
+/**
+ * @brief     start the cad without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora cad failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      returns right after SetCad, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status
+ */
+uint8_t sx1268_lora_cad_start(sx1268_handle_t *handle);
+
+/**
+ * @brief     start the single receive without waiting
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      returns right after SetRx, completion is reported by the irq handler through
+ *            the receive callback and sx1268_get_operation_status
+ */
+uint8_t sx1268_receive_start(sx1268_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get the status of the last started operation
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *operation points to an operation buffer
+ * @param[out] *status points to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_operation_status(sx1268_handle_t *handle, sx1268_operation_t *operation,
+                                    sx1268_operation_status_t *status);
+
+#if (SX1268_FLOAT_API == 1)
+/**
+ * @brief     enter to the single receive mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora single receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_single_receive(sx1268_handle_t *handle, double us);
+#endif
+
+/**
+ * @brief     enter to the single receive mode with an integer timeout
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] us is the rx timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora single receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_single_receive_integer(sx1268_handle_t *handle, uint32_t us);
+
+/**
+ * @brief     enter to the continuous receive mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 lora continuous receive failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_continuous_receive(sx1268_handle_t *handle);
+
+/**
+ * @brief     write the register
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] reg is the register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write register failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      read the register
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register address
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read register failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     write the buffer
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] offset is the buffer offset
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write buffer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      none
+ */
+uint8_t sx1268_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      read the buffer
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  offset is the buffer offset
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read buffer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      check the packet error
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *enable points to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_check_packet_error(sx1268_handle_t *handle, sx1268_bool_t *enable);
+
+/**
+ * @brief     begin recording commands into a batch
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] gap_us is the gap between two commands in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      write commands are recorded until sx1268_batch_commit is called,
+ *            a read command commits the recorded commands before it runs,
+ *            with the spi_writev link the commands go out in one transfer without busy checks,
+ *            so gap_us is waited with the chip select high after every command and must cover
+ *            the busy time of the recorded commands
+ */
+uint8_t sx1268_batch_begin(sx1268_handle_t *handle, uint16_t gap_us);
+
+/**
+ * @brief     commit the recorded batch commands
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 batch commit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      with the spi_writev link all commands are sent in one bus operation, a read or a
+ *            check inside the batch flushes it first and splits it
+ */
+uint8_t sx1268_batch_commit(sx1268_handle_t *handle);
+
+/**
+ * @brief     set the busy wait strategy
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] spin is the busy pin poll times before yielding
+ * @param[in] step_us is the yield step in us
+ * @param[in] timeout_us is the busy wait deadline in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 param is invalid
+ * @note      step_us is used with the delay_us link, otherwise the wait yields by 1 ms
+ */
+uint8_t sx1268_set_busy_wait(sx1268_handle_t *handle, uint16_t spin, uint16_t step_us, uint32_t timeout_us);
+
+/**
+ * @brief      get the busy wait strategy
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *spin points to a busy pin poll times buffer
+ * @param[out] *step_us points to a yield step buffer
+ * @param[out] *timeout_us points to a busy wait deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t sx1268_get_busy_wait(sx1268_handle_t *handle, uint16_t *spin, uint16_t *step_us, uint32_t *timeout_us);
+
+/**
+ * @brief     enable or disable the fast start mode
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      call it before sx1268_init, the reset pulse is SX1268_FAST_START_RESET_PULSE_US
+ *            with the delay_us link and the chip is ready as soon as the busy pin falls
+ */
+uint8_t sx1268_set_fast_start(sx1268_handle_t *handle, sx1268_bool_t enable);
+
+/**
+ * @brief      get the power on to standby time of the last sx1268_init
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *us points to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is measured with the get_time_us link, otherwise it is estimated
+ */
+uint8_t sx1268_get_start_time(sx1268_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      get the measured busy wait time
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *last_us points to a last busy wait time buffer
+ * @param[out] *max_us points to a max busy wait time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the time is measured with the get_time_us link, otherwise it is estimated from the delays
+ */
+uint8_t sx1268_get_busy_time(sx1268_handle_t *handle, uint32_t *last_us, uint32_t *max_us);
+
+/**
+ * @brief      get the chip state
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *state points to a chip state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the state is the last commanded mode updated by the irq handler,
+ *             a command sent in the sleep state wakes the chip up first
+ */
+uint8_t sx1268_get_chip_state(sx1268_handle_t *handle, sx1268_chip_state_t *state);
+
+/**
+ * @brief      get the last status byte
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *status points to a raw status buffer
+ * @param[out] *mode points to a chip mode buffer
+ * @param[out] *cmd_status points to a command status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       no bus access is done, the status byte is only harvested from read transactions:
+ *             get commands, read register and read buffer, writes and batches don't update it,
+ *             call sx1268_get_status to sample it after a write
+ */
+uint8_t sx1268_get_last_status(sx1268_handle_t *handle, uint8_t *status, sx1268_chip_mode_t *mode,
+                               sx1268_command_status_t *cmd_status);
+
+/**
+ * @brief      get the command error counter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *cnt points to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       command timeout, processing error and failure to execute are counted from the status
+ *             byte of read transactions only, the chip reports the status of the previous command,
+ *             so an error of a write is counted by the next read
+ */
+uint8_t sx1268_get_command_error_count(sx1268_handle_t *handle, uint32_t *cnt);
+
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is write through and is invalidated by this function, a reset and a cold sleep,
+ *            reads of the cached registers are served from ram once they are known
+ */
+uint8_t sx1268_set_register_cache(sx1268_handle_t *handle, sx1268_bool_t enable);
+
+/**
+ * @brief     enable or disable the configuration diff
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, set modulation params, set packet params, set rf frequency, set tx params,
+ *            set buffer base address, set standby and cached register writes identical to the last
+ *            applied values are not sent again
+ */
+uint8_t sx1268_set_config_diff(sx1268_handle_t *handle, sx1268_bool_t enable);
+
+/**
+ * @brief     enable or disable the configuration force flag
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, every command is sent even if it is unchanged, use it to recover the
+ *            chip configuration after an unexpected reset
+ */
+uint8_t sx1268_set_config_force(sx1268_handle_t *handle, sx1268_bool_t enable);
+
+/**
+ * @brief      read a list of registers
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  *reg points to a register address list
+ * @param[out] *value points to a value buffer
+ * @param[in]  num is the register number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read registers failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 num is over SX1268_REGISTERS_MAX_NUM
+ * @note       value[i] is the value of reg[i], the addresses are sorted and adjacent
+ *             addresses are merged into one burst read
+ */
+uint8_t sx1268_read_registers(sx1268_handle_t *handle, uint16_t *reg, uint8_t *value, uint16_t num);
+
+/**
+ * @brief     write a list of registers
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *reg points to a register address list
+ * @param[in] *value points to a value buffer
+ * @param[in] num is the register number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write registers failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is over SX1268_REGISTERS_MAX_NUM
+ * @note      value[i] is written to reg[i], the addresses are sorted and adjacent
+ *            addresses are merged into one burst write, a repeated address keeps the list order
+ */
+uint8_t sx1268_write_registers(sx1268_handle_t *handle, uint16_t *reg, uint8_t *value, uint16_t num);
+
+/**
+ * @brief     begin capturing the applied configuration
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a stream buffer
+ * @param[in] size is the stream buffer size
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      configuration commands and register writes are appended to the stream in bus
+ *            order as opcode, length and params after they are sent, a repeated command or a
+ *            register write covering an older one drops the older entry, unchanged commands
+ *            are not skipped while capturing, mode commands such as sleep, standby, tx and rx
+ *            and commands sent by the irq handler are not captured
+ */
+uint8_t sx1268_config_capture_begin(sx1268_handle_t *handle, uint8_t *buf, uint16_t size);
+
+/**
+ * @brief      end capturing the applied configuration
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *len points to a stream length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 stream buffer is too small
+ * @note       the stream can be stored in flash or a file and used by sx1268_config_replay
+ */
+uint8_t sx1268_config_capture_end(sx1268_handle_t *handle, uint16_t *len);
+
+/**
+ * @brief     replay a captured configuration stream
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a stream buffer
+ * @param[in] len is the stream length
+ * @param[in] gap_us is the gap between two commands in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 config replay failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 stream is invalid
+ *            - 6 batch is open
+ * @note      the stream is sent as batches with gap_us, the batch gap set by sx1268_batch_begin
+ *            is kept, the busy pin is only polled after the calibration and tcxo commands and
+ *            at the end of the stream, it can't run inside sx1268_batch_begin and sx1268_batch_commit
+ */
+uint8_t sx1268_config_replay(sx1268_handle_t *handle, uint8_t *buf, uint16_t len, uint16_t gap_us);
+
+/**
+ * @brief     set the register retention list
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *reg points to a register address list
+ * @param[in] num is the register number
+ * @return    status code
+ *            - 0 success
+ *            - 1 set retention list failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is over SX1268_RETENTION_LIST_MAX_NUM
+ * @note      the listed registers keep their values in the warm start sleep mode,
+ *            the list is lost after a reset or a cold start sleep
+ */
+uint8_t sx1268_set_retention_list(sx1268_handle_t *handle, uint16_t *reg, uint8_t num);
+
+/**
+ * @brief     wake up the chip and restore the lost registers
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ * @note      after a warm start only the cached registers which are not in the retention
+ *            list are written again, it needs the register cache
+ */
+uint8_t sx1268_wake_up(sx1268_handle_t *handle);
+
+/**
+ * @brief     initialize the frequency hopping table
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *freq points to a channel frequency list in Hz
+ * @param[in] *table points to a hop channel table
+ * @param[in] num is the channel number
+ * @param[in] mode is the hop mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 get random number or calibrate image failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 num is 0
+ * @note      the set rf frequency payload of every channel is precomputed into table,
+ *            the table must stay valid while hopping, one image band spanning all
+ *            channels is calibrated here so hopping never runs calibrate image,
+ *            the random sequence is seeded by sx1268_get_random_number
+ */
+uint8_t sx1268_hop_init(sx1268_handle_t *handle, uint32_t *freq, sx1268_hop_channel_t *table,
+                        uint8_t num, sx1268_hop_mode_t mode);
 
 /**
- * @brief     link delay_ms function
- * @param[in] HANDLE points to a sx1268 handle structure
- * @param[in] FUC points to a delay_ms function address
+ * @brief     enable or disable a hop channel
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] channel is the channel index
+ * @param[in] enable is a bool value, SX1268_BOOL_TRUE blacklists the channel
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 channel is invalid
  * @note      none
  */
-#define DRIVER_SX1268_LINK_DELAY_MS(HANDLE, FUC)                  (HANDLE)->delay_ms = FUC
+uint8_t sx1268_hop_set_blacklist(sx1268_handle_t *handle, uint8_t channel, sx1268_bool_t enable);
 
 /**
- * @brief     link debug_print function
- * @param[in] HANDLE points to a sx1268 handle structure
- * @param[in] FUC points to a debug_print function address
- * @note      none
+ * @brief     enable or disable hopping on completion
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] enable is a bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 hop table is not initialized
+ * @note      when enabled, sx1268_irq_handler retunes to the next channel on tx done,
+ *            single rx done and timeout after it runs the callbacks and before the
+ *            next queued frame is sent, a callback which starts tx, rx or cad keeps
+ *            the current channel and the hop happens on the next completion
  */
-#define DRIVER_SX1268_LINK_DEBUG_PRINT(HANDLE, FUC)               (HANDLE)->debug_print = FUC
+uint8_t sx1268_hop_set_enable(sx1268_handle_t *handle, sx1268_bool_t enable);
 
 /**
- * @brief     link receive_callback function
- * @param[in] HANDLE points to a sx1268 handle structure
- * @param[in] FUC points to a receive_callback function address
- * @note      none
+ * @brief      hop to the next channel
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *channel points to a channel index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 hop failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ *             - 5 no channel is available
+ * @note       the chip must be in the standby or fs mode
  */
-#define DRIVER_SX1268_LINK_RECEIVE_CALLBACK(HANDLE, FUC)          (HANDLE)->receive_callback = FUC
+uint8_t sx1268_hop_next(sx1268_handle_t *handle, uint8_t *channel);
 
 /**
- * @}
+ * @brief     stage the next lora frame in the idle half of the data buffer
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 stage failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 len is over SX1268_TX_PIPELINE_HALF_SIZE
+ *            - 6 a frame is already staged
+ * @note      it can be called while the previous frame is on air
  */
+uint8_t sx1268_lora_tx_stage(sx1268_handle_t *handle, uint8_t *buf, uint16_t len);
 
 /**
- * @defgroup sx1268_command_driver sx1268 command driver function
- * @brief    sx1268 command driver modules
- * @ingroup  sx1268_driver
- * @{
+ * @brief     start sending the staged lora frame
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] us is the timeout
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 no frame is staged
+ *            - 6 tx is running
+ * @note      it returns as soon as the chip is in tx, tx done is reported by sx1268_irq_handler,
+ *            with the register cache and the config diff only clear irq status, set buffer base address,
+ *            set packet params and set tx are sent, the blocking transmit functions write their
+ *            payload at the tx base address left by the pipeline
  */
+uint8_t sx1268_lora_tx_pipeline(sx1268_handle_t *handle, uint16_t preamble_length, sx1268_lora_header_t header_type,
+                                sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable, uint32_t us);
 
 /**
- * @brief      get chip's information
- * @param[out] *info points to a sx1268 info structure
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ * @brief     init the priority tx queue
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] standby_src is the clock source
+ * @param[in] preamble_length is the preamble length
+ * @param[in] header_type is the header type
+ * @param[in] crc_type is the crc type
+ * @param[in] invert_iq_enable is a bool value
+ * @param[in] us is the tx timeout of every queued frame
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      it drops all queued frames and must not run concurrently with sx1268_tx_queue_push
  */
-uint8_t sx1268_info(sx1268_info_t *info);
+uint8_t sx1268_tx_queue_init(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
+                             uint16_t preamble_length, sx1268_lora_header_t header_type,
+                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable, uint32_t us);
 
 /**
- * @brief     irq handler
+ * @brief     push a frame into the priority tx queue
  * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] priority is the frame priority
+ * @param[in] *buf points to a frame buffer
+ * @param[in] len is the frame length
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 5 tx queue is not initialized
+ *            - 6 priority or len is invalid
+ *            - 7 tx queue is full
+ * @note      it is lock free and can be called from several threads at the same time,
+ *            the buffer is not copied and must stay valid until its tx done or timeout callback,
+ *            len must not be over 256 - tx base address
  */
-uint8_t sx1268_irq_handler(sx1268_handle_t *handle);
+uint8_t sx1268_tx_queue_push(sx1268_handle_t *handle, sx1268_tx_priority_t priority, uint8_t *buf, uint16_t len);
 
 /**
- * @brief     initialize the chip
+ * @brief     start sending the queued frames
  * @param[in] *handle points to a sx1268 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 spi initialization failed
+ *            - 1 send failed
  *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 reset gpio initialization failed
- *            - 5 busy gpio initialization failed
- *            - 6 reset chip failed
- * @note      none
+ *            - 3 handle is not initialized
+ *            - 4 chip is busy
+ *            - 5 tx queue is not initialized
+ *            - 6 len is over the tx buffer
+ * @note      it does nothing if a queued frame is on air or the queue is empty, the following
+ *            frames are sent back to back by sx1268_irq_handler, it can be called from any
+ *            thread after sx1268_tx_queue_push, a compare and swap on the dispatcher flag lets
+ *            only one caller send at a time, the spi and busy links must be serialized by the
+ *            port if sx1268_irq_handler runs in another thread, a frame which fails to start
+ *            returns 1 and stays at the head of the queue until the next call, a frame over the
+ *            tx buffer returns 6 and stays at the head until the tx base address is lowered
  */
-uint8_t sx1268_init(sx1268_handle_t *handle);
+uint8_t sx1268_tx_queue_start(sx1268_handle_t *handle);
 
 /**
- * @brief     close the chip
+ * @brief     set the rx ring
  * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *buf points to a ring buffer of depth * slot_size bytes, NULL disables the ring
+ * @param[in] slot_size is the slot size including the 2 bytes length
+ * @param[in] depth is the slot number
  * @return    status code
  *            - 0 success
- *            - 1 spi deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- *            - 5 power down failed
- *            - 6 busy gpio deinit failed
- *            - 7 reset gpio deinit failed
- * @note      none
+ *            - 5 slot size or depth is invalid
+ * @note      with the ring sx1268_irq_handler stores every valid packet into the ring and
+ *            runs the rx done callback with a NULL buffer, call it while the chip is not in rx
  */
-uint8_t sx1268_deinit(sx1268_handle_t *handle);
+uint8_t sx1268_set_rx_ring(sx1268_handle_t *handle, uint8_t *buf, uint16_t slot_size, uint8_t depth);
 
 /**
- * @brief     sent the lora data
+ * @brief      read several packets from the rx ring
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *buf points to num buffers of size bytes each
+ * @param[in]  size is the size of each buffer
+ * @param[out] *len points to num length buffers
+ * @param[in]  num is the max packet number
+ * @param[out] *count points to a read packet number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 5 rx ring is not set
+ * @note       only one reader is allowed, packets longer than size are cut
+ */
+uint8_t sx1268_receive_batch(sx1268_handle_t *handle, uint8_t *buf, uint16_t size,
+                             uint16_t *len, uint8_t num, uint8_t *count);
+
+/**
+ * @brief      get the rx ring overflow counter
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *count points to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       packets dropped because the ring is full or the slot is too small
+ */
+uint8_t sx1268_get_rx_ring_overflow(sx1268_handle_t *handle, uint32_t *count);
+
+/**
+ * @brief     enable or disable the irq fast path
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] standby_src is the clock source
- * @param[in] preamble_length is the preamble length
- * @param[in] header_type is the header type
- * @param[in] crc_type is the crc type
- * @param[in] invert_iq_enable is a bool value
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
- * @param[in] us is the timeout
+ * @param[in] enable is a bool value
  * @return    status code
  *            - 0 success
- *            - 1 sent failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- *            - 5 sent timeout
- *            - 6 irq timeout
- *            - 7 unknown result
- * @note      none
+ * @note      with the fast path and the spi_writev link clear irq status, get rx buffer status and
+ *            get packet status (rx_packet_callback only) share one bus transfer, busy is polled
+ *            before it and the port waits SX1268_IRQ_FAST_PATH_GAP_US with the chip select high
+ *            between the commands instead of polling busy, a port that can not keep the gap after
+ *            the chip select rises must not link spi_writev, then the fast path stays off,
+ *            the payload read is always a separate transfer,
+ *            worst case bus transfers per irq without hop and tx queue:
+ *            get irq status 1, clear irq status with both status reads 1, timeout workaround 3
+ *            (every timeout as the errata requires), read buffer 1, the normal path needs one more
+ *            transfer on rx done and another one with rx_packet_callback
  */
-uint8_t sx1268_lora_transmit(sx1268_handle_t *handle, sx1268_clock_source_t standby_src,
-                             uint16_t preamble_length, sx1268_lora_header_t header_type,
-                             sx1268_lora_crc_type_t crc_type, sx1268_bool_t invert_iq_enable,
-                             uint8_t *buf, uint16_t len, uint32_t us);
+uint8_t sx1268_set_irq_fast_path(sx1268_handle_t *handle, sx1268_bool_t enable);
 
 /**
- * @brief      run the cad
+ * @brief      get the irq fast path status
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[out] *enable points to a enable buffer
+ * @param[out] *enable points to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 lora cad failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
- *             - 5 cad timeout
  * @note       none
  */
-uint8_t sx1268_lora_cad(sx1268_handle_t *handle, sx1268_bool_t *enable);
+uint8_t sx1268_get_irq_fast_path(sx1268_handle_t *handle, sx1268_bool_t *enable);
 
 /**
- * @brief     enter to the single receive mode
+ * @brief     register a handler for one irq type
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] us is the rx timeout
+ * @param[in] irq is the irq type
+ * @param[in] *handler points to a handler function, NULL unregisters it
  * @return    status code
  *            - 0 success
- *            - 1 lora single receive failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- * @note      none
+ *            - 5 irq is invalid
+ * @note      once a handler or the status callback is registered the receive callback is no longer
+ *            called from sx1268_irq_handler and irq types without a handler are skipped
  */
-uint8_t sx1268_single_receive(sx1268_handle_t *handle, double us);
+uint8_t sx1268_set_irq_handler(sx1268_handle_t *handle, sx1268_irq_t irq, void (*handler)(uint8_t *buf, uint16_t len));
 
 /**
- * @brief     enter to the continuous receive mode
+ * @brief     register the irq status word callback
  * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *callback points to a callback function, NULL unregisters it
  * @return    status code
  *            - 0 success
- *            - 1 lora continuous receive failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- * @note      none
+ * @note      it is called once per irq with the full irq status after the irq handlers
  */
-uint8_t sx1268_continuous_receive(sx1268_handle_t *handle);
+uint8_t sx1268_set_irq_status_callback(sx1268_handle_t *handle, void (*callback)(uint16_t status));
 
 /**
- * @brief     write the register
+ * @brief     set the rx address filter
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] reg is the register address
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
+ * @param[in] enable is a bool value
+ * @param[in] header_len is the peeked header length
+ * @param[in] address_offset is the address byte offset in the header
+ * @param[in] *match points to a match function, NULL uses the accepted address set
  * @return    status code
  *            - 0 success
- *            - 1 write register failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
- * @note      none
+ *            - 5 header_len is invalid
+ *            - 6 address_offset is over header_len
+ * @note      1 <= header_len <= SX1268_RX_FILTER_HEADER_MAX, match returns 1 to accept the packet,
+ *            a rejected or shorter packet is neither read nor passed to the callbacks
  */
-uint8_t sx1268_write_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
+uint8_t sx1268_set_rx_filter(sx1268_handle_t *handle, sx1268_bool_t enable, uint8_t header_len, uint8_t address_offset,
+                             uint8_t (*match)(uint8_t *header, uint8_t len));
 
 /**
- * @brief      read the register
+ * @brief      get the rx address filter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  reg is the register address
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
+ * @param[out] *enable points to a bool value buffer
+ * @param[out] *header_len points to a header length buffer
+ * @param[out] *address_offset points to an address offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 read register failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
  * @note       none
  */
-uint8_t sx1268_read_register(sx1268_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len);
+uint8_t sx1268_get_rx_filter(sx1268_handle_t *handle, sx1268_bool_t *enable, uint8_t *header_len, uint8_t *address_offset);
 
 /**
- * @brief     write the buffer
+ * @brief     add an accepted rx filter address
  * @param[in] *handle points to a sx1268 handle structure
- * @param[in] offset is the buffer offset
- * @param[in] *buf points to a data buffer
- * @param[in] len is the data length
+ * @param[in] address is the accepted address
  * @return    status code
  *            - 0 success
- *            - 1 write buffer failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 chip is busy
  * @note      none
  */
-uint8_t sx1268_write_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len);
+uint8_t sx1268_add_rx_filter_address(sx1268_handle_t *handle, uint8_t address);
 
 /**
- * @brief      read the buffer
+ * @brief     clear all accepted rx filter addresses
+ * @param[in] *handle points to a sx1268 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t sx1268_clear_rx_filter_address(sx1268_handle_t *handle);
+
+/**
+ * @brief      get the rx filter dropped packet counter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[in]  offset is the buffer offset
- * @param[out] *buf points to a data buffer
- * @param[in]  len is the data length
+ * @param[out] *count points to a counter buffer
  * @return     status code
  *             - 0 success
- *             - 1 read buffer failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 chip is busy
  * @note       none
  */
-uint8_t sx1268_read_buffer(sx1268_handle_t *handle, uint8_t offset, uint8_t *buf, uint16_t len);
+uint8_t sx1268_get_rx_filter_dropped(sx1268_handle_t *handle, uint32_t *count);
 
 /**
- * @brief      check the packet error
+ * @brief     set the rx buffer provider
+ * @param[in] *handle points to a sx1268 handle structure
+ * @param[in] *provider points to a provider function, NULL uses the inner receive buffer
+ * @param[in] *release points to a release function, it can be NULL only without a provider
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 release is NULL
+ * @note      provider is called from the irq handler with the payload length and returns the buffer
+ *            the payload is read into, the length can be 0 for an empty packet, a NULL buffer drops
+ *            the packet, every buffer it hands out goes back exactly once: through the rx done
+ *            callback as the last use by the driver, after rx_packet_callback, and it belongs to the
+ *            application afterwards, or through release when reading the payload fails or no rx done
+ *            callback is registered, the rx ring is used before the provider
+ */
+uint8_t sx1268_set_rx_buffer_provider(sx1268_handle_t *handle, uint8_t *(*provider)(uint16_t len),
+                                      void (*release)(uint8_t *buf));
+
+/**
+ * @brief      get the rx buffer provider dropped packet counter
  * @param[in]  *handle points to a sx1268 handle structure
- * @param[out] *enable points to a bool buffer
+ * @param[out] *count points to a counter buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t sx1268_check_packet_error(sx1268_handle_t *handle, sx1268_bool_t *enable);
+uint8_t sx1268_get_rx_buffer_dropped(sx1268_handle_t *handle, uint32_t *count);
 
 /**
  * @brief     enter to the sleep mode
@@ -812,6 +2143,7 @@ uint8_t sx1268_set_tx(sx1268_handle_t *handle, uint32_t timeout);
  */
 uint8_t sx1268_set_rx(sx1268_handle_t *handle, uint32_t timeout);
 
+#if (SX1268_FLOAT_API == 1)
 /**
  * @brief      convert the timeout to the register raw data
  * @param[in]  *handle points to a sx1268 handle structure
@@ -837,6 +2169,33 @@ uint8_t sx1268_timeout_convert_to_register(sx1268_handle_t *handle, double us, u
  * @note       none
  */
 uint8_t sx1268_timeout_convert_to_data(sx1268_handle_t *handle, uint32_t reg, double *us);
+#endif
+
+/**
+ * @brief      convert the integer timeout to the register raw data
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  us is the timeout in us
+ * @param[out] *reg points to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one step is 15.625 us, the result is rounded down
+ */
+uint8_t sx1268_timeout_convert_to_register_integer(sx1268_handle_t *handle, uint32_t us, uint32_t *reg);
+
+/**
+ * @brief      convert the register raw data to the integer timeout
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[in]  reg is the register raw data
+ * @param[out] *us points to a us buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one step is 15.625 us, the result is rounded down
+ */
+uint8_t sx1268_timeout_convert_to_data_integer(sx1268_handle_t *handle, uint32_t reg, uint32_t *us);
 
 /**
  * @brief     stop timer on preamble
@@ -1163,6 +2522,7 @@ uint8_t sx1268_set_gfsk_modulation_params(sx1268_handle_t *handle, uint32_t br,
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 br is 0
  * @note       none
  */
 uint8_t sx1268_gfsk_bit_rate_convert_to_register(sx1268_handle_t *handle, uint32_t br, uint32_t *reg);
@@ -1176,6 +2536,7 @@ uint8_t sx1268_gfsk_bit_rate_convert_to_register(sx1268_handle_t *handle, uint32
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 reg is 0
  * @note       none
  */
 uint8_t sx1268_gfsk_bit_rate_convert_to_data(sx1268_handle_t *handle, uint32_t reg, uint32_t *br);
@@ -1348,6 +2709,7 @@ uint8_t sx1268_get_status(sx1268_handle_t *handle, uint8_t *status);
  */
 uint8_t sx1268_get_rx_buffer_status(sx1268_handle_t *handle, uint8_t *payload_length_rx, uint8_t *rx_start_buffer_pointer);
 
+#if (SX1268_FLOAT_API == 1)
 /**
  * @brief      get the packet status in GFSK mode
  * @param[in]  *handle points to a sx1268 handle structure
@@ -1401,6 +2763,55 @@ uint8_t sx1268_get_lora_packet_status(sx1268_handle_t *handle, uint8_t *rssi_pkt
  * @note       none
  */
 uint8_t sx1268_get_instantaneous_rssi(sx1268_handle_t *handle, uint8_t *rssi_inst_raw, float *rssi_inst);
+#endif
+
+/**
+ * @brief      get the packet status in GFSK mode with integer results
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rx_status points to a rx status buffer
+ * @param[out] *rssi_sync points to a rssi sync buffer in 0.01 dBm
+ * @param[out] *rssi_avg points to a rssi avg buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get gfsk packet status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_gfsk_packet_status_integer(sx1268_handle_t *handle, uint8_t *rx_status, 
+                                              int16_t *rssi_sync, int16_t *rssi_avg);
+
+/**
+ * @brief      get the packet status in LoRa mode with integer results
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rssi_pkt points to a rssi packet buffer in 0.01 dBm
+ * @param[out] *snr_pkt points to a snr packet buffer in 0.01 dB
+ * @param[out] *signal_rssi_pkt points to a signal rssi packet buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get lora packet status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_lora_packet_status_integer(sx1268_handle_t *handle, int16_t *rssi_pkt, 
+                                              int16_t *snr_pkt, int16_t *signal_rssi_pkt);
+
+/**
+ * @brief      get the instantaneous rssi with an integer result
+ * @param[in]  *handle points to a sx1268 handle structure
+ * @param[out] *rssi_inst points to a rssi instantaneous buffer in 0.01 dBm
+ * @return     status code
+ *             - 0 success
+ *             - 1 get instantaneous rssi failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 chip is busy
+ * @note       none
+ */
+uint8_t sx1268_get_instantaneous_rssi_integer(sx1268_handle_t *handle, int16_t *rssi_inst);
 
 /**
  * @brief      get the stats
@@ -36,6 +36,7 @@
 
 #include "driver_sx1268_register_test.h"
 #include <stdlib.h>
+#include <string.h>
 
 static sx1268_handle_t gs_handle;        /**< sx1268 handle */
 
@@ -64,12 +65,35 @@ uint8_t sx1268_register_test(void)
     uint8_t trim, trim_check;
     uint8_t mask, mask_check;
     uint8_t enable, enable_check;
+#if (SX1268_FLOAT_API == 1)
     double us, us_check;
+#else
+    uint32_t us_integer, us_integer_check;
+#endif
     uint32_t freq, freq_check;
     uint32_t br, br_check;
     uint32_t reg;
     sx1268_packet_type_t type;
     sx1268_info_t info;
+    sx1268_irq_profile_t profile;
+    uint16_t irq_mask;
+    uint32_t irq_num, packet_num;
+    uint16_t irq_per_packet;
+    uint16_t spin, step_us;
+    uint32_t timeout_us;
+    uint32_t last_us, max_us;
+    sx1268_chip_state_t state;
+    uint8_t status;
+    sx1268_chip_mode_t mode;
+    sx1268_command_status_t cmd_status;
+    uint32_t cnt, cnt_check;
+    uint16_t regs[3];
+    uint8_t values[3], values_check[3];
+    uint8_t capture[64];
+    uint16_t capture_len;
+    uint8_t retention[5];
+    sx1268_bool_t bool_check;
+    uint8_t header_len, offset;
     
     /* link interface function */
     DRIVER_SX1268_LINK_INIT(&gs_handle, sx1268_handle_t);
@@ -176,6 +200,7 @@ uint8_t sx1268_register_test(void)
     }
     sx1268_interface_debug_print("sx1268: check buffer %s.\n", control_check == control ? "ok" : "error");
     
+#if (SX1268_FLOAT_API == 1)
     /* sx1268_timeout_convert_to_register/sx1268_timeout_convert_to_data test */
     sx1268_interface_debug_print("sx1268: sx1268_timeout_convert_to_register/sx1268_timeout_convert_to_data test.\n");
     
@@ -199,6 +224,31 @@ uint8_t sx1268_register_test(void)
     }
     sx1268_interface_debug_print("sx1268: check timeout %f us.\n", us_check);
     
+#else
+    /* sx1268_timeout_convert_to_register_integer/sx1268_timeout_convert_to_data_integer test */
+    sx1268_interface_debug_print("sx1268: sx1268_timeout_convert_to_register_integer/sx1268_timeout_convert_to_data_integer test.\n");
+    
+    us_integer = rand() % 10000;
+    res = sx1268_timeout_convert_to_register_integer(&gs_handle, us_integer, (uint32_t *)&reg);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: timeout convert to register failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set timeout %d us.\n", us_integer);
+    res = sx1268_timeout_convert_to_data_integer(&gs_handle, reg, (uint32_t *)&us_integer_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: timeout convert to data failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check timeout %d us.\n", us_integer_check);
+#endif
+    
     /* sx1268_frequency_convert_to_register/sx1268_frequency_convert_to_data test */
     sx1268_interface_debug_print("sx1268: sx1268_frequency_convert_to_register/sx1268_frequency_convert_to_data test.\n");
     
@@ -838,6 +888,703 @@ uint8_t sx1268_register_test(void)
     }
     sx1268_interface_debug_print("sx1268: check pull down control %s.\n", control == control_check ? "ok" : "error");
     
+    /* sx1268_set_irq_profile/sx1268_get_irq_profile/sx1268_get_irq_statistics test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_irq_profile/sx1268_get_irq_profile/sx1268_get_irq_statistics test.\n");
+    
+    res = sx1268_set_irq_profile(&gs_handle, SX1268_IRQ_PROFILE_COMPLETION, 
+                                 SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set irq profile failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set completion irq profile.\n");
+    res = sx1268_get_irq_profile(&gs_handle, (sx1268_irq_profile_t *)&profile, (uint16_t *)&irq_mask);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get irq profile failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check irq profile %s.\n", ((profile == SX1268_IRQ_PROFILE_COMPLETION) && 
+                                 (irq_mask == (SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT))) ? "ok" : "error");
+    if ((profile != SX1268_IRQ_PROFILE_COMPLETION) || (irq_mask != (SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT)))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_irq_statistics(&gs_handle, (uint32_t *)&irq_num, (uint32_t *)&packet_num, (uint16_t *)&irq_per_packet);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get irq statistics failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check irq statistics %s.\n", ((irq_num == 0) && (packet_num == 0) && 
+                                 (irq_per_packet == 0)) ? "ok" : "error");
+    if ((irq_num != 0) || (packet_num != 0) || (irq_per_packet != 0))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_irq_profile(&gs_handle, SX1268_IRQ_PROFILE_ALL, 
+                                 SX1268_IRQ_TX_DONE | SX1268_IRQ_RX_DONE | SX1268_IRQ_TIMEOUT);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set irq profile failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set all irq profile.\n");
+    res = sx1268_get_irq_profile(&gs_handle, (sx1268_irq_profile_t *)&profile, (uint16_t *)&irq_mask);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get irq profile failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check irq profile %s.\n", (profile == SX1268_IRQ_PROFILE_ALL) ? "ok" : "error");
+    if (profile != SX1268_IRQ_PROFILE_ALL)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_busy_wait/sx1268_get_busy_wait/sx1268_get_busy_time test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_busy_wait/sx1268_get_busy_wait/sx1268_get_busy_time test.\n");
+    
+    res = sx1268_set_busy_wait(&gs_handle, 64, 10, 100000);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set busy wait failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set busy wait spin 64 step 10 us timeout 100000 us.\n");
+    res = sx1268_get_busy_wait(&gs_handle, (uint16_t *)&spin, (uint16_t *)&step_us, (uint32_t *)&timeout_us);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get busy wait failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check busy wait %s.\n", ((spin == 64) && (step_us == 10) && 
+                                 (timeout_us == 100000)) ? "ok" : "error");
+    if ((spin != 64) || (step_us != 10) || (timeout_us != 100000))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_rx_gain(&gs_handle, (uint8_t *)&gain_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx gain failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_busy_time(&gs_handle, (uint32_t *)&last_us, (uint32_t *)&max_us);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get busy time failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check busy time %s.\n", ((max_us >= last_us) && (last_us <= 100000)) ? "ok" : "error");
+    if ((max_us < last_us) || (last_us > 100000))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_get_chip_state test */
+    sx1268_interface_debug_print("sx1268: sx1268_get_chip_state test.\n");
+    
+    res = sx1268_set_standby(&gs_handle, SX1268_CLOCK_SOURCE_RC_13M);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set standby failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set standby rc.\n");
+    res = sx1268_get_chip_state(&gs_handle, (sx1268_chip_state_t *)&state);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get chip state failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check chip state %s.\n", state == SX1268_CHIP_STATE_STANDBY_RC ? "ok" : "error");
+    if (state != SX1268_CHIP_STATE_STANDBY_RC)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_sleep(&gs_handle, SX1268_START_MODE_WARM, SX1268_BOOL_FALSE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set sleep failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set warm sleep.\n");
+    res = sx1268_get_chip_state(&gs_handle, (sx1268_chip_state_t *)&state);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get chip state failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check chip state %s.\n", state == SX1268_CHIP_STATE_SLEEP ? "ok" : "error");
+    if (state != SX1268_CHIP_STATE_SLEEP)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_delay_ms(1);
+    res = sx1268_get_rx_gain(&gs_handle, (uint8_t *)&gain_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx gain failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: wake up by a command.\n");
+    res = sx1268_get_chip_state(&gs_handle, (sx1268_chip_state_t *)&state);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get chip state failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check chip state %s.\n", state == SX1268_CHIP_STATE_STANDBY_RC ? "ok" : "error");
+    if (state != SX1268_CHIP_STATE_STANDBY_RC)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_get_last_status/sx1268_get_command_error_count test */
+    sx1268_interface_debug_print("sx1268: sx1268_get_last_status/sx1268_get_command_error_count test.\n");
+    
+    res = sx1268_get_command_error_count(&gs_handle, (uint32_t *)&cnt);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get command error count failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_status(&gs_handle, (uint8_t *)&status);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get status failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_last_status(&gs_handle, (uint8_t *)&status, (sx1268_chip_mode_t *)&mode, 
+                                 (sx1268_command_status_t *)&cmd_status);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get last status failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: last status is 0x%02X.\n", status);
+    sx1268_interface_debug_print("sx1268: check last status %s.\n", mode == SX1268_CHIP_MODE_STBY_RC ? "ok" : "error");
+    if (mode != SX1268_CHIP_MODE_STBY_RC)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_command_error_count(&gs_handle, (uint32_t *)&cnt_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get command error count failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check command error count %s.\n", cnt == cnt_check ? "ok" : "error");
+    if (cnt != cnt_check)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_register_cache test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_register_cache test.\n");
+    
+    res = sx1268_set_register_cache(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set register cache failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: enable register cache.\n");
+    gain = 0x94;
+    res = sx1268_set_rx_gain(&gs_handle, gain);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set rx gain failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_rx_gain(&gs_handle, (uint8_t *)&gain_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx gain failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check cached rx gain %s.\n", gain == gain_check ? "ok" : "error");
+    if (gain != gain_check)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_register_cache(&gs_handle, SX1268_BOOL_FALSE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set register cache failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: disable register cache.\n");
+    res = sx1268_get_rx_gain(&gs_handle, (uint8_t *)&gain_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx gain failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check rx gain %s.\n", gain == gain_check ? "ok" : "error");
+    if (gain != gain_check)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_config_diff/sx1268_set_config_force test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_config_diff/sx1268_set_config_force test.\n");
+    
+    res = sx1268_set_config_diff(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set config diff failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: enable config diff.\n");
+    res = sx1268_set_packet_type(&gs_handle, SX1268_PACKET_TYPE_LORA);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set packet type failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_packet_type(&gs_handle, SX1268_PACKET_TYPE_LORA);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set packet type failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set packet type lora twice.\n");
+    res = sx1268_get_packet_type(&gs_handle, &type);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get packet type failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check packet type %s.\n", type == SX1268_PACKET_TYPE_LORA ? "ok" : "error");
+    if (type != SX1268_PACKET_TYPE_LORA)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_config_force(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set config force failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: enable config force.\n");
+    res = sx1268_set_packet_type(&gs_handle, SX1268_PACKET_TYPE_LORA);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set packet type failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_packet_type(&gs_handle, &type);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get packet type failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check forced packet type %s.\n", type == SX1268_PACKET_TYPE_LORA ? "ok" : "error");
+    if (type != SX1268_PACKET_TYPE_LORA)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_config_force(&gs_handle, SX1268_BOOL_FALSE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set config force failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_config_diff(&gs_handle, SX1268_BOOL_FALSE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set config diff failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: disable config diff.\n");
+    
+    /* sx1268_write_registers/sx1268_read_registers test */
+    sx1268_interface_debug_print("sx1268: sx1268_write_registers/sx1268_read_registers test.\n");
+    
+    regs[0] = 0x0740;
+    regs[1] = 0x0741;
+    regs[2] = 0x08AC;
+    values[0] = rand() % 256;
+    values[1] = rand() % 256;
+    values[2] = 0x96;
+    res = sx1268_write_registers(&gs_handle, (uint16_t *)regs, (uint8_t *)values, 3);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: write registers failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: write registers 0x%02X 0x%02X 0x%02X.\n", values[0], values[1], values[2]);
+    res = sx1268_read_registers(&gs_handle, (uint16_t *)regs, (uint8_t *)values_check, 3);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: read registers failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check registers %s.\n", memcmp(values, values_check, 3) == 0 ? "ok" : "error");
+    if (memcmp(values, values_check, 3) != 0)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_config_capture_begin/sx1268_config_capture_end/sx1268_config_replay test */
+    sx1268_interface_debug_print("sx1268: sx1268_config_capture_begin/sx1268_config_capture_end/sx1268_config_replay test.\n");
+    
+    res = sx1268_config_capture_begin(&gs_handle, (uint8_t *)capture, 64);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: config capture begin failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    value = rand() % 65536;
+    res = sx1268_set_lora_sync_word(&gs_handle, value);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set lora sync word failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_config_capture_end(&gs_handle, (uint16_t *)&capture_len);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: config capture end failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: capture lora sync word 0x%04X in %d bytes.\n", value, capture_len);
+    res = sx1268_set_lora_sync_word(&gs_handle, (uint16_t)(~value));
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set lora sync word failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_config_replay(&gs_handle, (uint8_t *)capture, capture_len, 0);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: config replay failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_get_lora_sync_word(&gs_handle, (uint16_t *)&value_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get lora sync word failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check replayed lora sync word %s.\n", value == value_check ? "ok" : "error");
+    if (value != value_check)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_batch_begin(&gs_handle, 100);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: batch begin failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_config_replay(&gs_handle, (uint8_t *)capture, capture_len, 0);
+    sx1268_interface_debug_print("sx1268: check replay in an open batch %s.\n", res == 6 ? "ok" : "error");
+    if (res != 6)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_batch_commit(&gs_handle);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: batch commit failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_retention_list test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_retention_list test.\n");
+    
+    regs[0] = 0x08AC;
+    regs[1] = 0x08E7;
+    res = sx1268_set_retention_list(&gs_handle, (uint16_t *)regs, 2);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set retention list failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: set retention list 0x%04X 0x%04X.\n", regs[0], regs[1]);
+    res = sx1268_read_register(&gs_handle, 0x029F, (uint8_t *)retention, 5);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: read register failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check retention list %s.\n", ((retention[0] == 2) && (retention[1] == 0x08) && (retention[2] == 0xAC) && 
+                                 (retention[3] == 0x08) && (retention[4] == 0xE7)) ? "ok" : "error");
+    if ((retention[0] != 2) || (retention[1] != 0x08) || (retention[2] != 0xAC) || 
+        (retention[3] != 0x08) || (retention[4] != 0xE7))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_irq_fast_path/sx1268_get_irq_fast_path test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_irq_fast_path/sx1268_get_irq_fast_path test.\n");
+    
+    res = sx1268_set_irq_fast_path(&gs_handle, SX1268_BOOL_TRUE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set irq fast path failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: enable irq fast path.\n");
+    res = sx1268_get_irq_fast_path(&gs_handle, &bool_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get irq fast path failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check irq fast path %s.\n", bool_check == SX1268_BOOL_TRUE ? "ok" : "error");
+    if (bool_check != SX1268_BOOL_TRUE)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_irq_fast_path(&gs_handle, SX1268_BOOL_FALSE);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set irq fast path failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: disable irq fast path.\n");
+    res = sx1268_get_irq_fast_path(&gs_handle, &bool_check);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get irq fast path failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check irq fast path %s.\n", bool_check == SX1268_BOOL_FALSE ? "ok" : "error");
+    if (bool_check != SX1268_BOOL_FALSE)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* sx1268_set_rx_filter/sx1268_get_rx_filter test */
+    sx1268_interface_debug_print("sx1268: sx1268_set_rx_filter/sx1268_get_rx_filter test.\n");
+    
+    res = sx1268_set_rx_filter(&gs_handle, SX1268_BOOL_TRUE, 2, 1, NULL);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set rx filter failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: enable rx filter.\n");
+    res = sx1268_get_rx_filter(&gs_handle, &bool_check, &header_len, &offset);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx filter failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check rx filter %s.\n",
+                                 ((bool_check == SX1268_BOOL_TRUE) && (header_len == 2) && (offset == 1)) ? "ok" : "error");
+    if ((bool_check != SX1268_BOOL_TRUE) || (header_len != 2) || (offset != 1))
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    addr = rand() % 256;
+    res = sx1268_add_rx_filter_address(&gs_handle, addr);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: add rx filter address failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: add rx filter address 0x%02X.\n", addr);
+    res = sx1268_clear_rx_filter_address(&gs_handle);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: clear rx filter address failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: clear rx filter address.\n");
+    res = sx1268_get_rx_filter_dropped(&gs_handle, &cnt);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx filter dropped failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check rx filter dropped %s.\n", cnt == 0 ? "ok" : "error");
+    if (cnt != 0)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = sx1268_set_rx_filter(&gs_handle, SX1268_BOOL_FALSE, 2, 1, NULL);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: set rx filter failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: disable rx filter.\n");
+    res = sx1268_get_rx_filter(&gs_handle, &bool_check, &header_len, &offset);
+    if (res != 0)
+    {
+        sx1268_interface_debug_print("sx1268: get rx filter failed.\n");
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    sx1268_interface_debug_print("sx1268: check rx filter %s.\n", bool_check == SX1268_BOOL_FALSE ? "ok" : "error");
+    if (bool_check != SX1268_BOOL_FALSE)
+    {
+        (void)sx1268_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* finish register test */
     sx1268_interface_debug_print("sx1268: finish register test.\n");
     (void)sx1268_deinit(&gs_handle);
@@ -61,16 +61,23 @@ static void a_callback(uint16_t type, uint8_t *buf, uint16_t len)
         {
             uint16_t i;
             sx1268_bool_t enable;
+#if (SX1268_FLOAT_API == 1)
             uint8_t rssi_pkt_raw;
             uint8_t snr_pkt_raw;
             uint8_t signal_rssi_pkt_raw;
             float rssi_pkt;
             float snr_pkt;
             float signal_rssi_pkt;
+#else
+            int16_t rssi_pkt;
+            int16_t snr_pkt;
+            int16_t signal_rssi_pkt;
+#endif
             
             sx1268_interface_debug_print("sx1268: irq rx done.\n");
             
             /* get the status */
+#if (SX1268_FLOAT_API == 1)
             if (sx1268_get_lora_packet_status(&gs_handle, (uint8_t *)&rssi_pkt_raw, (uint8_t *)&snr_pkt_raw,
                                              (uint8_t *)&signal_rssi_pkt_raw, (float *)&rssi_pkt,
                                              (float *)&snr_pkt, (float *)&signal_rssi_pkt) != 0)
@@ -80,6 +87,16 @@ static void a_callback(uint16_t type, uint8_t *buf, uint16_t len)
             sx1268_interface_debug_print("sx1268: rssi is %0.1f.\n", rssi_pkt);
             sx1268_interface_debug_print("sx1268: snr is %0.2f.\n", snr_pkt);
             sx1268_interface_debug_print("sx1268: signal rssi is %0.1f.\n", signal_rssi_pkt);
+#else
+            if (sx1268_get_lora_packet_status_integer(&gs_handle, (int16_t *)&rssi_pkt, (int16_t *)&snr_pkt,
+                                                      (int16_t *)&signal_rssi_pkt) != 0)
+            {
+                return;
+            }
+            sx1268_interface_debug_print("sx1268: rssi is %d (0.01 dBm).\n", rssi_pkt);
+            sx1268_interface_debug_print("sx1268: snr is %d (0.01 dB).\n", snr_pkt);
+            sx1268_interface_debug_print("sx1268: signal rssi is %d (0.01 dBm).\n", signal_rssi_pkt);
+#endif
             
             /* check the error */
             if (sx1268_check_packet_error(&gs_handle, &enable) != 0)